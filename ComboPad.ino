@@ -3,7 +3,7 @@
 // - 모듈 초기화 순서 통합
 // - 설정(NVS) 로드→적용
 // - 부팅 팩토리 진입 윈도우 처리
-// - 런타임 입력/CLI 폴링
+// - CLI 폴링 (런타임 입력은 InputScheduler 태스크가 고정 주기로 처리)
 //
 
 #include <Arduino.h>
@@ -26,6 +26,7 @@
 #include "imu/IMU.h"
 
 #include "input/RuntimeInput.h"
+#include "input/InputScheduler.h"
 #include "factory/FactoryTests.h"
 
 // ==============================
@@ -45,10 +46,82 @@ static bool   g_factoryChecked = false;
 static uint32_t g_bootStartMs  = 0;
 static uint32_t g_factoryHoldStart = 0;
 
+// ==============================
+// 런타임 반영 훅(ConfigStore::applyToRuntime → 각 모듈 setter)
+// ==============================
+struct RuntimeHooks : ConfigStore::IRuntimeHooks {
+  void onStickCurve(float deadzone, float gamma) override {
+    RuntimeInput::setStickCurve(deadzone, gamma);
+  }
+
+  void onStickAutoCal(bool en) override { RuntimeInput::setStickAutoCal(en); }
+
+  void onFilters(uint8_t joyMode, float joyMin, float joyBeta, float joyDc,
+                 uint8_t tpMode, float tpMin, float tpBeta, float tpDc) override {
+    RuntimeInput::setFilters(joyMode, OneEuro::Params{ joyMin, joyBeta, joyDc },
+                             tpMode,  OneEuro::Params{ tpMin,  tpBeta,  tpDc });
+  }
+
+  // 입력 스케줄러 주기/분주비(begin 전이면 시작 주기로 사용)
+  void onInputSchedule(uint16_t rateHz, uint8_t divGesture, uint8_t divTouch,
+                       uint8_t divSlider, uint8_t divGamepad) override {
+    InputScheduler::setRate(rateHz);
+    RuntimeInput::Dividers div;
+    div.gesture  = divGesture;
+    div.touchpad = divTouch;
+    div.slider   = divSlider;
+    div.gamepad  = divGamepad;
+    RuntimeInput::setDividers(div);
+  }
+
+  // ADC 샘플링 모드(Continuous 시작 실패 시 HAL이 OneShot 유지)
+  //  - 드라이버 재시작이 따르므로 값이 바뀐 경우에만 요청(다른 cfg set마다 DMA를 끊지 않게)
+  void onAdcMode(uint8_t mode, uint8_t oversample, uint8_t reduce) override {
+    const uint32_t key = ((uint32_t)mode << 16) | ((uint32_t)oversample << 8) | reduce;
+    if (adcApplied && key == adcKey) return;
+    adcApplied = true;
+    adcKey     = key;
+    if (!HAL::adcSetMode(mode ? HAL::AdcMode::Continuous : HAL::AdcMode::OneShot,
+                         oversample, static_cast<HAL::AdcReduce>(reduce))) {
+      LOGW("CFG", "ADC continuous start failed → oneshot");
+    }
+  }
+
+  void onDebounce(uint16_t pressMs, uint16_t releaseMs, bool eager) override {
+    RuntimeInput::setDebounce(pressMs, releaseMs, eager);
+  }
+
+  void onPointerAccel(bool en, float accMin, float accMax, float vMax, float exp) override {
+    PointerBallistics::Params acc;
+    acc.enabled = en;
+    acc.accMin  = accMin;
+    acc.accMax  = accMax;
+    acc.vMax    = vMax;
+    acc.exp     = exp;
+    RuntimeInput::setPointerAccel(acc);
+  }
+
+  // 키보드 탭(줌) 최대 속도
+  void onKeyTapRate(uint16_t hz) override { USBDevices::setKeyTapRate(hz); }
+
+  // 하프틱 마스터 ON/OFF
+  void onHapticsEnable(bool en) override { HapticsRuntime::setEnabled(en); }
+
+  // 하프틱 정책 파라미터(ERM 최소 듀티 % 등)
+  void onErmMinPct(uint8_t pct) override { HapticsPolicy::setErmMinPct(pct); }
+
+  void onLogMask(uint32_t mask) override { Log::setMask(mask); }
+
+  bool     adcApplied = false;
+  uint32_t adcKey     = 0;
+};
+
+static RuntimeHooks g_runtimeHooks;
+
 // ==============================
 // 내부 함수 원형
 // ==============================
-static void applyConfigToRuntime();          // NVS 구성 → 런타임 모듈 반영
+static void applyConfigToRuntime();          // NVS 구성 → 런타임 모듈 반영(ConfigStore 훅 경유)
 static void checkFactoryEntryDuringBoot();   // 부팅 윈도우 내 공장 모드 진입
 static void showReadyBlink();                // 준비 표시(현재 모드 LED 짧은 점등)
 
@@ -68,7 +141,11 @@ void setup() {
   // 2) HAL (핀/I2C/ADC/터치)
   HAL::init();
 
-  // 3) USB 장치 래퍼
+  // 3) USB 장치 래퍼 — 폴링 간격은 디스크립터에 들어가므로 설정을 먼저 읽음(런타임 반영은 7단계)
+  ConfigStore::load();
+  USBDevices::setPollMs(ConfigStore::get().usb_poll_ms);
+  USBDevices::setGamepadHiRes(ConfigStore::get().pad_hires);
+  USBDevices::setCombined(ConfigStore::get().usb_combined);
   USBDevices::init(kUsbProduct, kUsbManufacturer, kUsbSerial);
 
   // 4) 하프틱(정책 → 런타임 순으로)
@@ -82,12 +159,14 @@ void setup() {
   // 6) IMU (가능 시 시작)
   IMU::init();
 
-  // 7) 설정(NVS) → 로드 → 런타임 반영
-  ConfigStore::load();           // 내부적으로 버전 확인/마이그레이션 처리
+  // 7) 설정(NVS) → 런타임 반영(로드는 3단계에서 완료 — 버전 확인/마이그레이션 포함)
+  //    훅을 등록해 두면 CLI `cfg set`의 applyToRuntime도 재부팅 없이 즉시 반영됨
+  ConfigStore::setHooks(&g_runtimeHooks);
   applyConfigToRuntime();
 
-  // 8) 입력 엔진(터치/슬라이더/게임패드 파이프라인 묶음)
+  // 8) 입력 엔진(터치/슬라이더/게임패드 파이프라인 묶음) → 고정 주기 스케줄러 시작
   RuntimeInput::init();
+  InputScheduler::begin(ConfigStore::get().input_hz);
 
   // 9) 팩토리/스모크 테스트 모듈
   FactoryTests::init();
@@ -112,10 +191,11 @@ void loop() {
   // 2) CLI 폴링(설정/로그/팩토리 명령 수용)
   MainCLI::poll();   // 논블로킹
 
-  // 3) 런타임 입력 처리(터치→마우스, 슬라이더→휠/줌, 게임패드, 제스처)
-  RuntimeInput::tick(millis());
+  // 3) 코얼레싱된 NVS 쓰기(스틱 보정값 등) — 입력 태스크 밖에서 수행
+  ConfigStore::service(millis());
 
-  // 4) 필요 시 여유 딜레이 (주 타이밍은 각 모듈 내부에서 조정)
+  // 4) 런타임 입력은 InputScheduler(esp_timer → 입력 태스크)가 처리
+  //    loop는 CLI/부팅 윈도우 감시/NVS 서비스만 하므로 여유 딜레이로 충분
   delay(5);
 }
 
@@ -124,20 +204,7 @@ void loop() {
 // ==============================
 static void applyConfigToRuntime() {
   const auto &cfg = ConfigStore::get();
-
-  // 로그 마스크
-  Log::setMask(cfg.log_mask);
-
-  // 커서/슬라이더 파라미터/모드 — 입력 엔진에 전달
-  RuntimeInput::setCursorGain(cfg.cursor_gain);
-  RuntimeInput::setSliderParams(cfg.slider_thresh, cfg.zoom_step_dv, cfg.wheel_step_dv);
-  RuntimeInput::setInitialSliderMode(cfg.initial_mode); // 0: wheel, 1: zoom
-
-  // 하프틱 마스터 ON/OFF
-  HapticsRuntime::setEnabled(cfg.haptics_on);
-
-  // 하프틱 정책 파라미터(ERM 최소 듀티 % 등)
-  HapticsPolicy::setErmMinPct(cfg.erm_min_pct);
+  ConfigStore::applyToRuntime(cfg);
 
   LOGI("CFG",
        "applied: gain=%.2f slth=%d zstep=%d wstep=%d mode=%s haptics=%s ermMin=%u%% log=0x%08lx",
@@ -13,6 +13,31 @@
 #define CFG_DEFAULT_LOG_MASK 0x0000003F  // 하위 주요 카테고리 ON
 #endif
 
+// USB HID 폴링 간격(bInterval, ms: 1|2|4|8) 기본값 — NVS usb_poll_ms가 우선
+#ifndef CFG_USB_POLL_MS
+#define CFG_USB_POLL_MS 1
+#endif
+
+// 게임패드 리포트 기본 형식(0: 표준 int8 축, 1: int16 축 + 16비트 트리거) — NVS pad_hires가 우선
+#ifndef CFG_PAD_HIRES
+#define CFG_PAD_HIRES 0
+#endif
+
+// 게임패드+포인터 통합 리포트(0: 인터페이스별 리포트, 1: 리포트 ID 하나로 통합 — raw/evdev 전용, OS 커서 없음) — NVS usb_combined가 우선
+#ifndef CFG_USB_COMBINED
+#define CFG_USB_COMBINED 0
+#endif
+
+// MPR121 IRQ 기반 터치 수집(1: IRQ 때만 버스트 읽기, 0: tick마다 버스트 읽기)
+#ifndef CFG_TOUCH_IRQ
+#define CFG_TOUCH_IRQ 1
+#endif
+
+// 키보드 탭(줌 등) 최대 속도(탭/초, 0 = flush마다 1회) — NVS kbd_tap_hz가 우선
+#ifndef CFG_KBD_TAP_HZ
+#define CFG_KBD_TAP_HZ 30
+#endif
+
 // 컴파일러 경고 강화(가능한 경우)
 #if defined(__GNUC__)
   #pragma GCC diagnostic error "-Wall"
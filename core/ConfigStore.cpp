@@ -4,31 +4,140 @@
 #include "Log.h"
 
 #include <Preferences.h>
+#include "freertos/FreeRTOS.h"
 
 namespace ConfigStore {
 
 const char* KEY_VER     = "cfg.ver";
 const char* KEY_GAIN    = "gain";
 const char* KEY_SLTH    = "slth";
+const char* KEY_PACC    = "pacc";
+const char* KEY_PAMIN   = "pamin";
+const char* KEY_PAMAX   = "pamax";
+const char* KEY_PAV     = "pav";
+const char* KEY_PAEXP   = "paexp";
+const char* KEY_TPTAP   = "tptap";
+const char* KEY_TPTMS   = "tptms";
+const char* KEY_TPGAP   = "tpgap";
+const char* KEY_TPDRG   = "tpdrg";
+const char* KEY_TPLKM   = "tplkm";
+const char* KEY_TPHLD   = "tphld";
+const char* KEY_TPHL2   = "tphl2";
+const char* KEY_TPEDG   = "tpedg";
+const char* KEY_TPIN    = "tpin";
+const char* KEY_TPITAU  = "tpitau";
+const char* KEY_TPISTP  = "tpistp";
 const char* KEY_ZSTEP   = "zstep";
 const char* KEY_WSTEP   = "wstep";
 const char* KEY_MODE    = "mode";
+const char* KEY_WHAX    = "whax";
+const char* KEY_SLADP   = "sladp";
+const char* KEY_SLVLO   = "slvlo";
+const char* KEY_SLVHI   = "slvhi";
+const char* KEY_SLGLO   = "slglo";
+const char* KEY_SLGHI   = "slghi";
+const char* KEY_JDZ     = "jdz";
+const char* KEY_JGAM    = "jgam";
+const char* KEY_JAC     = "jac";
+const char* KEY_JFLT    = "jflt";
+const char* KEY_JFMIN   = "jfmin";
+const char* KEY_JFBETA  = "jfbeta";
+const char* KEY_JFDC    = "jfdc";
+const char* KEY_TFLT    = "tflt";
+const char* KEY_TFMIN   = "tfmin";
+const char* KEY_TFBETA  = "tfbeta";
+const char* KEY_TFDC    = "tfdc";
+const char* KEY_STKCAL  = "stkcal";
+const char* KEY_INHZ    = "inhz";
+const char* KEY_DIVG    = "divg";
+const char* KEY_DIVT    = "divt";
+const char* KEY_DIVS    = "divs";
+const char* KEY_DIVP    = "divp";
+const char* KEY_ADCM    = "adcm";
+const char* KEY_ADCOS   = "adcos";
+const char* KEY_ADCRD   = "adcrd";
+const char* KEY_DEBP    = "debp";
+const char* KEY_DEBR    = "debr";
+const char* KEY_DEBE    = "debe";
+const char* KEY_USBPI   = "usbpi";
+const char* KEY_PADHR   = "padhr";
+const char* KEY_USBCMB  = "usbcmb";
+const char* KEY_KBDHZ   = "kbdhz";
 const char* KEY_HAPT    = "hap";
 const char* KEY_ERMPCT  = "ermpct";
 const char* KEY_LOGMASK = "logmask";
 
 static IRuntimeHooks* s_hooks = nullptr;
 
+// ---- 스틱 보정 blob 쓰기 코얼레싱 ----
+static constexpr uint32_t STAGE_SETTLE_MS       = 5000;    // 변경이 잦아든 뒤 기록
+static constexpr uint32_t STAGE_MIN_INTERVAL_MS = 60000;   // 플래시 마모 방지 최소 간격
+
+static portMUX_TYPE s_stageMux = portMUX_INITIALIZER_UNLOCKED;
+static StickCal  s_staged;
+static bool      s_stagedDirty   = false;
+static uint32_t  s_stagedAtMs    = 0;
+static uint32_t  s_lastBlobWrite = 0;
+static bool      s_blobWritten   = false;
+
 void setHooks(IRuntimeHooks* hooks){ s_hooks = hooks; }
 
 // 기본값 채우기
 static void fillDefaults(Config& c){
   c.version       = CFG_SCHEMA_VERSION;
   c.cursor_gain   = 18.0f;
+  c.ptr_accel     = false;
+  c.ptr_acc_min   = 0.6f;
+  c.ptr_acc_max   = 3.0f;
+  c.ptr_acc_v     = 40.0f;
+  c.ptr_acc_exp   = 1.5f;
+  c.tp_tap_mode   = 1;
+  c.tp_tap_ms     = 180;
+  c.tp_gap_ms     = 300;
+  c.tp_drag       = 1;
+  c.tp_lock_ms    = 800;
+  c.tp_hold_ms    = 600;
+  c.tp_hold2_ms   = 1200;
+  c.tp_edge       = true;
+  c.tp_inertia    = 0;
+  c.tp_in_tau_ms  = 350;
+  c.tp_in_stop    = 2.0f;
   c.slider_thresh = 25;
   c.zoom_step_dv  = 150;
   c.wheel_step_dv = 40;
   c.initial_mode  = SL_WHEEL;
+  c.wheel_axis    = WHEEL_VERTICAL;
+  c.sl_adapt      = false;
+  c.sl_v_lo       = 200;
+  c.sl_v_hi       = 2500;
+  c.sl_g_lo       = 0.5f;
+  c.sl_g_hi       = 3.0f;
+  c.joy_deadzone  = 0.15f;
+  c.joy_gamma     = 1.4f;
+  c.joy_autocal   = true;
+  c.joy_filter    = 0;
+  c.joy_f_min     = 2.0f;
+  c.joy_f_beta    = 1.0f;
+  c.joy_f_dc      = 1.0f;
+  c.tp_filter     = 0;
+  c.tp_f_min      = 1.5f;
+  c.tp_f_beta     = 0.3f;
+  c.tp_f_dc       = 1.0f;
+  c.input_hz      = 500;
+  c.div_gesture   = 2;
+  c.div_touch     = 2;
+  c.div_slider    = 2;
+  c.div_gamepad   = 1;
+  c.adc_mode      = 1;
+  c.adc_os        = 8;
+  c.adc_reduce    = 2;
+  c.deb_press_ms  = 5;
+  c.deb_release_ms= 10;
+  c.deb_eager     = false;
+  c.usb_poll_ms   = CFG_USB_POLL_MS;
+  c.pad_hires     = CFG_PAD_HIRES;
+  c.usb_combined  = CFG_USB_COMBINED;
+  c.kbd_tap_hz    = CFG_KBD_TAP_HZ;
   c.haptics_on    = true;
   c.erm_min_pct   = 50;
   c.log_mask      = CFG_DEFAULT_LOG_MASK;
@@ -71,10 +180,58 @@ bool load(Config& out){
   Config c;
   c.version       = ver;
   c.cursor_gain   = prefs.getFloat(KEY_GAIN,    18.0f);
+  c.ptr_accel     = prefs.getBool(KEY_PACC,     false);
+  c.ptr_acc_min   = prefs.getFloat(KEY_PAMIN,   0.6f);
+  c.ptr_acc_max   = prefs.getFloat(KEY_PAMAX,   3.0f);
+  c.ptr_acc_v     = prefs.getFloat(KEY_PAV,     40.0f);
+  c.ptr_acc_exp   = prefs.getFloat(KEY_PAEXP,   1.5f);
+  c.tp_tap_mode   = prefs.getUChar(KEY_TPTAP,   1);
+  c.tp_tap_ms     = prefs.getUShort(KEY_TPTMS,  180);
+  c.tp_gap_ms     = prefs.getUShort(KEY_TPGAP,  300);
+  c.tp_drag       = prefs.getUChar(KEY_TPDRG,   1);
+  c.tp_lock_ms    = prefs.getUShort(KEY_TPLKM,  800);
+  c.tp_hold_ms    = prefs.getUShort(KEY_TPHLD,  600);
+  c.tp_hold2_ms   = prefs.getUShort(KEY_TPHL2,  1200);
+  c.tp_edge       = prefs.getBool(KEY_TPEDG,    true);
+  c.tp_inertia    = prefs.getUChar(KEY_TPIN,    0);
+  c.tp_in_tau_ms  = prefs.getUShort(KEY_TPITAU, 350);
+  c.tp_in_stop    = prefs.getFloat(KEY_TPISTP,  2.0f);
   c.slider_thresh = prefs.getInt(KEY_SLTH,      25);
   c.zoom_step_dv  = prefs.getInt(KEY_ZSTEP,     150);
   c.wheel_step_dv = prefs.getInt(KEY_WSTEP,     40);
   c.initial_mode  = (uint8_t)prefs.getUChar(KEY_MODE,   SL_WHEEL);
+  c.wheel_axis    = prefs.getUChar(KEY_WHAX,    WHEEL_VERTICAL);
+  c.sl_adapt      = prefs.getBool(KEY_SLADP,    false);
+  c.sl_v_lo       = prefs.getUShort(KEY_SLVLO,  200);
+  c.sl_v_hi       = prefs.getUShort(KEY_SLVHI,  2500);
+  c.sl_g_lo       = prefs.getFloat(KEY_SLGLO,   0.5f);
+  c.sl_g_hi       = prefs.getFloat(KEY_SLGHI,   3.0f);
+  c.joy_deadzone  = prefs.getFloat(KEY_JDZ,     0.15f);
+  c.joy_gamma     = prefs.getFloat(KEY_JGAM,    1.4f);
+  c.joy_autocal   = prefs.getBool(KEY_JAC,      true);
+  c.joy_filter    = prefs.getUChar(KEY_JFLT,    0);
+  c.joy_f_min     = prefs.getFloat(KEY_JFMIN,   2.0f);
+  c.joy_f_beta    = prefs.getFloat(KEY_JFBETA,  1.0f);
+  c.joy_f_dc      = prefs.getFloat(KEY_JFDC,    1.0f);
+  c.tp_filter     = prefs.getUChar(KEY_TFLT,    0);
+  c.tp_f_min      = prefs.getFloat(KEY_TFMIN,   1.5f);
+  c.tp_f_beta     = prefs.getFloat(KEY_TFBETA,  0.3f);
+  c.tp_f_dc       = prefs.getFloat(KEY_TFDC,    1.0f);
+  c.input_hz      = prefs.getUShort(KEY_INHZ,   500);
+  c.div_gesture   = prefs.getUChar(KEY_DIVG,    2);
+  c.div_touch     = prefs.getUChar(KEY_DIVT,    2);
+  c.div_slider    = prefs.getUChar(KEY_DIVS,    2);
+  c.div_gamepad   = prefs.getUChar(KEY_DIVP,    1);
+  c.adc_mode      = prefs.getUChar(KEY_ADCM,    1);
+  c.adc_os        = prefs.getUChar(KEY_ADCOS,   8);
+  c.adc_reduce    = prefs.getUChar(KEY_ADCRD,   2);
+  c.deb_press_ms  = prefs.getUShort(KEY_DEBP,   5);
+  c.deb_release_ms= prefs.getUShort(KEY_DEBR,   10);
+  c.deb_eager     = prefs.getBool(KEY_DEBE,     false);
+  c.usb_poll_ms   = prefs.getUChar(KEY_USBPI,   CFG_USB_POLL_MS);
+  c.pad_hires     = prefs.getBool(KEY_PADHR,    CFG_PAD_HIRES);
+  c.usb_combined  = prefs.getBool(KEY_USBCMB,   CFG_USB_COMBINED);
+  c.kbd_tap_hz    = prefs.getUShort(KEY_KBDHZ,  CFG_KBD_TAP_HZ);
   c.haptics_on    = prefs.getBool(KEY_HAPT,     true);
   c.erm_min_pct   = prefs.getUChar(KEY_ERMPCT,  50);
   c.log_mask      = prefs.getULong(KEY_LOGMASK, CFG_DEFAULT_LOG_MASK);
@@ -90,6 +247,49 @@ bool load(Config& out){
   // 보정: 범위 클램프(미래에 잘못된 값 방어)
   if (c.erm_min_pct > 100) c.erm_min_pct = 100;
   if (c.initial_mode != SL_WHEEL && c.initial_mode != SL_ZOOM) c.initial_mode = SL_WHEEL;
+  if (c.wheel_axis != WHEEL_VERTICAL && c.wheel_axis != WHEEL_PAN) c.wheel_axis = WHEEL_VERTICAL;
+  if (!(c.ptr_acc_min > 0.0f) || c.ptr_acc_min > 20.0f) c.ptr_acc_min = 0.6f;
+  if (!(c.ptr_acc_max > 0.0f) || c.ptr_acc_max > 20.0f) c.ptr_acc_max = 3.0f;
+  if (!(c.ptr_acc_v   > 0.0f) || c.ptr_acc_v   > 1000.0f) c.ptr_acc_v = 40.0f;
+  if (!(c.ptr_acc_exp >= 0.2f) || c.ptr_acc_exp > 5.0f) c.ptr_acc_exp = 1.5f;
+  if (c.tp_tap_mode > 2) c.tp_tap_mode = 1;
+  if (c.tp_drag > 2)     c.tp_drag = 1;
+  if (c.tp_tap_ms < 50 || c.tp_tap_ms > 1000) c.tp_tap_ms = 180;
+  if (c.tp_gap_ms < 50 || c.tp_gap_ms > 1000) c.tp_gap_ms = 300;
+  if (c.tp_lock_ms > 5000) c.tp_lock_ms = 800;
+  if (c.tp_hold_ms && c.tp_hold_ms <= c.tp_tap_ms) c.tp_hold_ms = 600;
+  if (c.tp_hold2_ms <= c.tp_hold_ms || c.tp_hold2_ms >= 2500) c.tp_hold2_ms = 1200;   // 2.5 s부터는 모드 토글 홀드
+  if (c.tp_inertia > 2) c.tp_inertia = 0;
+  if (c.tp_in_tau_ms < 50 || c.tp_in_tau_ms > 3000) c.tp_in_tau_ms = 350;
+  if (!(c.tp_in_stop >= 0.1f) || c.tp_in_stop > 50.0f) c.tp_in_stop = 2.0f;
+  if (c.sl_v_hi <= c.sl_v_lo){ c.sl_v_lo = 200; c.sl_v_hi = 2500; }
+  if (!(c.sl_g_lo > 0.0f) || c.sl_g_lo > 20.0f) c.sl_g_lo = 0.5f;
+  if (!(c.sl_g_hi > 0.0f) || c.sl_g_hi > 20.0f) c.sl_g_hi = 3.0f;
+  if (c.joy_deadzone < 0.0f)  c.joy_deadzone = 0.0f;
+  if (c.joy_deadzone > 0.95f) c.joy_deadzone = 0.95f;
+  if (c.joy_gamma < 0.2f)     c.joy_gamma = 0.2f;
+  if (c.joy_gamma > 4.0f)     c.joy_gamma = 4.0f;
+  if (c.joy_filter > 1) c.joy_filter = 0;
+  if (c.tp_filter  > 1) c.tp_filter  = 0;
+  if (!(c.joy_f_min > 0.0f) || c.joy_f_min > 30.0f) c.joy_f_min = 2.0f;
+  if (!(c.joy_f_dc  > 0.0f) || c.joy_f_dc  > 30.0f) c.joy_f_dc  = 1.0f;
+  if (!(c.tp_f_min  > 0.0f) || c.tp_f_min  > 30.0f) c.tp_f_min  = 1.5f;
+  if (!(c.tp_f_dc   > 0.0f) || c.tp_f_dc   > 30.0f) c.tp_f_dc   = 1.0f;
+  if (!(c.joy_f_beta >= 0.0f) || c.joy_f_beta > 100.0f) c.joy_f_beta = 1.0f;
+  if (!(c.tp_f_beta  >= 0.0f) || c.tp_f_beta  > 100.0f) c.tp_f_beta  = 0.3f;
+  if (c.input_hz != 250 && c.input_hz != 500 && c.input_hz != 1000) c.input_hz = 500;
+  if (!c.div_gesture) c.div_gesture = 1;
+  if (!c.div_touch)   c.div_touch   = 1;
+  if (!c.div_slider)  c.div_slider  = 1;
+  if (!c.div_gamepad) c.div_gamepad = 1;
+  if (c.adc_mode > 1)   c.adc_mode = 1;
+  if (c.adc_os < 1)     c.adc_os = 1;
+  if (c.adc_os > 16)    c.adc_os = 16;
+  if (c.adc_reduce > 2) c.adc_reduce = 2;
+  if (c.deb_press_ms   > 60) c.deb_press_ms   = 60;
+  if (c.deb_release_ms > 60) c.deb_release_ms = 60;
+  if (c.usb_poll_ms != 1 && c.usb_poll_ms != 2 && c.usb_poll_ms != 4 && c.usb_poll_ms != 8) c.usb_poll_ms = CFG_USB_POLL_MS;
+  if (c.kbd_tap_hz > 1000) c.kbd_tap_hz = 1000;
 
   out = c;
   LOGC(CONFIG, "[NVS] loaded (ver=%u)", (unsigned)out.version);
@@ -106,10 +306,58 @@ bool save(const Config& in){
   // 현재 스키마 버전으로 강제 저장
   prefs.putUShort(KEY_VER,     CFG_SCHEMA_VERSION);
   prefs.putFloat (KEY_GAIN,    in.cursor_gain);
+  prefs.putBool  (KEY_PACC,    in.ptr_accel);
+  prefs.putFloat (KEY_PAMIN,   in.ptr_acc_min);
+  prefs.putFloat (KEY_PAMAX,   in.ptr_acc_max);
+  prefs.putFloat (KEY_PAV,     in.ptr_acc_v);
+  prefs.putFloat (KEY_PAEXP,   in.ptr_acc_exp);
+  prefs.putUChar (KEY_TPTAP,   in.tp_tap_mode);
+  prefs.putUShort(KEY_TPTMS,   in.tp_tap_ms);
+  prefs.putUShort(KEY_TPGAP,   in.tp_gap_ms);
+  prefs.putUChar (KEY_TPDRG,   in.tp_drag);
+  prefs.putUShort(KEY_TPLKM,   in.tp_lock_ms);
+  prefs.putUShort(KEY_TPHLD,   in.tp_hold_ms);
+  prefs.putUShort(KEY_TPHL2,   in.tp_hold2_ms);
+  prefs.putBool  (KEY_TPEDG,   in.tp_edge);
+  prefs.putUChar (KEY_TPIN,    in.tp_inertia);
+  prefs.putUShort(KEY_TPITAU,  in.tp_in_tau_ms);
+  prefs.putFloat (KEY_TPISTP,  in.tp_in_stop);
   prefs.putInt   (KEY_SLTH,    in.slider_thresh);
   prefs.putInt   (KEY_ZSTEP,   in.zoom_step_dv);
   prefs.putInt   (KEY_WSTEP,   in.wheel_step_dv);
   prefs.putUChar (KEY_MODE,    in.initial_mode);
+  prefs.putUChar (KEY_WHAX,    in.wheel_axis);
+  prefs.putBool  (KEY_SLADP,   in.sl_adapt);
+  prefs.putUShort(KEY_SLVLO,   in.sl_v_lo);
+  prefs.putUShort(KEY_SLVHI,   in.sl_v_hi);
+  prefs.putFloat (KEY_SLGLO,   in.sl_g_lo);
+  prefs.putFloat (KEY_SLGHI,   in.sl_g_hi);
+  prefs.putFloat (KEY_JDZ,     in.joy_deadzone);
+  prefs.putFloat (KEY_JGAM,    in.joy_gamma);
+  prefs.putBool  (KEY_JAC,     in.joy_autocal);
+  prefs.putUChar (KEY_JFLT,    in.joy_filter);
+  prefs.putFloat (KEY_JFMIN,   in.joy_f_min);
+  prefs.putFloat (KEY_JFBETA,  in.joy_f_beta);
+  prefs.putFloat (KEY_JFDC,    in.joy_f_dc);
+  prefs.putUChar (KEY_TFLT,    in.tp_filter);
+  prefs.putFloat (KEY_TFMIN,   in.tp_f_min);
+  prefs.putFloat (KEY_TFBETA,  in.tp_f_beta);
+  prefs.putFloat (KEY_TFDC,    in.tp_f_dc);
+  prefs.putUShort(KEY_INHZ,    in.input_hz);
+  prefs.putUChar (KEY_DIVG,    in.div_gesture);
+  prefs.putUChar (KEY_DIVT,    in.div_touch);
+  prefs.putUChar (KEY_DIVS,    in.div_slider);
+  prefs.putUChar (KEY_DIVP,    in.div_gamepad);
+  prefs.putUChar (KEY_ADCM,    in.adc_mode);
+  prefs.putUChar (KEY_ADCOS,   in.adc_os);
+  prefs.putUChar (KEY_ADCRD,   in.adc_reduce);
+  prefs.putUShort(KEY_DEBP,    in.deb_press_ms);
+  prefs.putUShort(KEY_DEBR,    in.deb_release_ms);
+  prefs.putBool  (KEY_DEBE,    in.deb_eager);
+  prefs.putUChar (KEY_USBPI,   in.usb_poll_ms);
+  prefs.putBool  (KEY_PADHR,   in.pad_hires);
+  prefs.putBool  (KEY_USBCMB,  in.usb_combined);
+  prefs.putUShort(KEY_KBDHZ,   in.kbd_tap_hz);
   prefs.putBool  (KEY_HAPT,    in.haptics_on);
   prefs.putUChar (KEY_ERMPCT,  in.erm_min_pct);
   prefs.putULong (KEY_LOGMASK, in.log_mask);
@@ -125,10 +373,37 @@ void reset(Config& out){
 }
 
 void show(const Config& c){
-  LOGC(CONFIG, "ver=%u gain=%.2f slth=%d zstep=%d wstep=%d mode=%s hap=%s ermMin=%u%% logmask=0x%08lX",
+  LOGC(CONFIG, "ver=%u gain=%.2f slth=%d zstep=%d wstep=%d mode=%s jdz=%.2f jgam=%.2f hap=%s ermMin=%u%% logmask=0x%08lX",
        (unsigned)c.version, c.cursor_gain, c.slider_thresh, c.zoom_step_dv, c.wheel_step_dv,
-       (c.initial_mode==SL_ZOOM?"zoom":"wheel"),
+       (c.initial_mode==SL_ZOOM?"zoom":"wheel"), c.joy_deadzone, c.joy_gamma,
        (c.haptics_on?"on":"off"), c.erm_min_pct, (unsigned long)c.log_mask);
+  LOGC(CONFIG, "ptr accel=%s min=%.2f max=%.2f v=%.1f cells/s exp=%.2f",
+       (c.ptr_accel ? "on" : "off"), c.ptr_acc_min, c.ptr_acc_max, c.ptr_acc_v, c.ptr_acc_exp);
+  static const char* kTap[]  = { "off", "tap", "double" };
+  static const char* kDrag[] = { "off", "drag", "lock" };
+  LOGC(CONFIG, "touch tap=%s(%ums gap=%ums) drag=%s(lock=%ums) hold=%u/%ums edge=%s",
+       kTap[c.tp_tap_mode > 2 ? 2 : c.tp_tap_mode], (unsigned)c.tp_tap_ms, (unsigned)c.tp_gap_ms,
+       kDrag[c.tp_drag > 2 ? 2 : c.tp_drag], (unsigned)c.tp_lock_ms,
+       (unsigned)c.tp_hold_ms, (unsigned)c.tp_hold2_ms, (c.tp_edge ? "on" : "off"));
+  static const char* kInertia[] = { "off", "scroll", "all" };
+  LOGC(CONFIG, "touch inertia=%s tau=%ums stop=%.1f cells/s",
+       kInertia[c.tp_inertia > 2 ? 2 : c.tp_inertia], (unsigned)c.tp_in_tau_ms, c.tp_in_stop);
+  LOGC(CONFIG, "wheel axis=%s", (c.wheel_axis == WHEEL_PAN ? "pan" : "vertical"));
+  LOGC(CONFIG, "slider adapt=%s v=%u..%u/s gain=%.2f..%.2f",
+       (c.sl_adapt ? "on" : "off"), (unsigned)c.sl_v_lo, (unsigned)c.sl_v_hi, c.sl_g_lo, c.sl_g_hi);
+  LOGC(CONFIG, "joy autocal=%s", (c.joy_autocal ? "on" : "off"));
+  LOGC(CONFIG, "filter joy=%s(min=%.2f beta=%.2f dc=%.2f) tp=%s(min=%.2f beta=%.2f dc=%.2f)",
+       (c.joy_filter ? "1e" : "ema"), c.joy_f_min, c.joy_f_beta, c.joy_f_dc,
+       (c.tp_filter ? "1e" : "off"), c.tp_f_min, c.tp_f_beta, c.tp_f_dc);
+  LOGC(CONFIG, "input=%uHz div(g/t/s/p)=%u/%u/%u/%u",
+       (unsigned)c.input_hz, c.div_gesture, c.div_touch, c.div_slider, c.div_gamepad);
+  static const char* kReduce[] = { "avg", "median", "trimmed" };
+  LOGC(CONFIG, "adc=%s os=%u reduce=%s",
+       (c.adc_mode ? "dma" : "oneshot"), c.adc_os, kReduce[c.adc_reduce > 2 ? 2 : c.adc_reduce]);
+  LOGC(CONFIG, "debounce press=%ums release=%ums eager=%s",
+       (unsigned)c.deb_press_ms, (unsigned)c.deb_release_ms, (c.deb_eager ? "on" : "off"));
+  LOGC(CONFIG, "usb poll=%ums pad=%s combined=%s kbdTap=%u/s", (unsigned)c.usb_poll_ms,
+       (c.pad_hires ? "hires16" : "std8"), (c.usb_combined ? "on" : "off"), (unsigned)c.kbd_tap_hz);
 }
 
 void applyToRuntime(const Config& c){
@@ -136,13 +411,86 @@ void applyToRuntime(const Config& c){
     LOGC(CONFIG, "[CFG] applyToRuntime skipped (no hooks)");
     return;
   }
-  s_hooks->onCursorGain(c.cursor_gain);
-  s_hooks->onSliderParams(c.slider_thresh, c.zoom_step_dv, c.wheel_step_dv);
-  s_hooks->onInitialMode(c.initial_mode);
+  s_hooks->onStickCurve(c.joy_deadzone, c.joy_gamma);
+  s_hooks->onStickAutoCal(c.joy_autocal);
+  s_hooks->onFilters(c.joy_filter, c.joy_f_min, c.joy_f_beta, c.joy_f_dc,
+                     c.tp_filter, c.tp_f_min, c.tp_f_beta, c.tp_f_dc);
+  s_hooks->onInputSchedule(c.input_hz, c.div_gesture, c.div_touch, c.div_slider, c.div_gamepad);
+  s_hooks->onAdcMode(c.adc_mode, c.adc_os, c.adc_reduce);
+  s_hooks->onDebounce(c.deb_press_ms, c.deb_release_ms, c.deb_eager);
+  s_hooks->onPointerAccel(c.ptr_accel, c.ptr_acc_min, c.ptr_acc_max, c.ptr_acc_v, c.ptr_acc_exp);
+  s_hooks->onKeyTapRate(c.kbd_tap_hz);
   s_hooks->onHapticsEnable(c.haptics_on);
   s_hooks->onErmMinPct(c.erm_min_pct);
   s_hooks->onLogMask(c.log_mask);
   LOGC(CONFIG, "[CFG] applied to runtime");
 }
 
+bool loadStickCal(StickCal& out){
+  Preferences prefs;
+  if (!prefs.begin(CFG_NVS_NAMESPACE, /*readOnly=*/true)) return false;
+  bool ok = false;
+  if (prefs.getBytesLength(KEY_STKCAL) == sizeof(StickCal)){
+    StickCal c;
+    prefs.getBytes(KEY_STKCAL, &c, sizeof(c));
+    ok = (c.ver == STICKCAL_VER && c.axes == 4);
+    if (ok) out = c;
+  }
+  prefs.end();
+  return ok;
+}
+
+static bool writeStickCal(const StickCal& c){
+  Preferences prefs;
+  if (!prefs.begin(CFG_NVS_NAMESPACE, /*readOnly=*/false)){
+    LOGC(CONFIG, "[NVS] open(write) failed (stkcal)");
+    return false;
+  }
+  const size_t n = prefs.putBytes(KEY_STKCAL, &c, sizeof(c));
+  prefs.end();
+  return n == sizeof(c);
+}
+
+void stageStickCal(const StickCal& cal){
+  const uint32_t now = millis();
+  portENTER_CRITICAL(&s_stageMux);
+  s_staged      = cal;
+  s_stagedDirty = true;
+  s_stagedAtMs  = now;
+  portEXIT_CRITICAL(&s_stageMux);
+}
+
+static void writeStaged(uint32_t now_ms){
+  StickCal c;
+  portENTER_CRITICAL(&s_stageMux);
+  c = s_staged;
+  s_stagedDirty = false;
+  portEXIT_CRITICAL(&s_stageMux);
+
+  if (writeStickCal(c)){
+    s_lastBlobWrite = now_ms;
+    s_blobWritten   = true;
+    LOGC(CONFIG, "[NVS] stick cal saved");
+  }
+}
+
+void service(uint32_t now_ms){
+  bool dirty; uint32_t at;
+  portENTER_CRITICAL(&s_stageMux);
+  dirty = s_stagedDirty; at = s_stagedAtMs;
+  portEXIT_CRITICAL(&s_stageMux);
+  if (!dirty) return;
+  if (now_ms - at < STAGE_SETTLE_MS) return;
+  if (s_blobWritten && now_ms - s_lastBlobWrite < STAGE_MIN_INTERVAL_MS) return;
+  writeStaged(now_ms);
+}
+
+void flushStaged(){
+  bool dirty;
+  portENTER_CRITICAL(&s_stageMux);
+  dirty = s_stagedDirty;
+  portEXIT_CRITICAL(&s_stageMux);
+  if (dirty) writeStaged(millis());
+}
+
 } // namespace ConfigStore
@@ -5,17 +5,30 @@
 #include <Arduino.h>
 #include <stdint.h>
 
+#include "BuildOpts.h"
+
 namespace ConfigStore {
 
 // 초기 모드(슬라이더)
 enum : uint8_t { SL_WHEEL = 0, SL_ZOOM = 1 };
 
-// 외부 런타임 반영 훅(오케스트라/런타임이 구현)
+// 슬라이더 휠 모드의 스크롤 축
+enum : uint8_t { WHEEL_VERTICAL = 0, WHEEL_PAN = 1 };
+
+// 외부 런타임 반영 훅(오케스트라가 구현 — ComboPad.ino)
+//  - 커서 gain/슬라이더 파라미터/초기 모드는 파이프라인이 get()으로 직접 읽으므로 훅 없음
 struct IRuntimeHooks {
   virtual ~IRuntimeHooks() = default;
-  virtual void onCursorGain(float) = 0;
-  virtual void onSliderParams(int thresh, int zstep, int wstep) = 0;
-  virtual void onInitialMode(uint8_t mode) = 0;
+  virtual void onStickCurve(float deadzone, float gamma) = 0;
+  virtual void onInputSchedule(uint16_t rateHz, uint8_t divGesture, uint8_t divTouch,
+                               uint8_t divSlider, uint8_t divGamepad) = 0;
+  virtual void onAdcMode(uint8_t mode, uint8_t oversample, uint8_t reduce) = 0;
+  virtual void onDebounce(uint16_t pressMs, uint16_t releaseMs, bool eager) = 0;
+  virtual void onStickAutoCal(bool en) = 0;
+  virtual void onFilters(uint8_t joyMode, float joyMin, float joyBeta, float joyDc,
+                         uint8_t tpMode, float tpMin, float tpBeta, float tpDc) = 0;
+  virtual void onPointerAccel(bool en, float accMin, float accMax, float vMax, float exp) = 0;
+  virtual void onKeyTapRate(uint16_t hz) = 0;
   virtual void onHapticsEnable(bool en) = 0;
   virtual void onErmMinPct(uint8_t pct) = 0;
   virtual void onLogMask(uint32_t mask) = 0;
@@ -28,10 +41,84 @@ struct Config {
 
   // 커서/입력 파라미터
   float   cursor_gain   = 18.0f;
+  // 커서 가속 곡선: 배율 = min + (max-min)·(속도/v)^exp (속도: 셀/s), 끄면 선형 gain
+  bool    ptr_accel     = false;
+  float   ptr_acc_min   = 0.6f;
+  float   ptr_acc_max   = 3.0f;
+  float   ptr_acc_v     = 40.0f;
+  float   ptr_acc_exp   = 1.5f;
+  // 터치패드 제스처(TouchGestures): 탭 0 끔/1 탭=클릭/2 더블탭만, 드래그 0 끔/1 탭-드래그/2 +드래그 락
+  //  - 홀드: tp_hold_ms에 우클릭 준비, tp_hold2_ms까지 유지하면 취소(0 = 홀드 끔)
+  //  - 가장자리 스크롤: 오른쪽 가장자리 세로 휠, 아래 가장자리 가로(AC Pan)
+  uint8_t  tp_tap_mode  = 1;
+  uint16_t tp_tap_ms    = 180;
+  uint16_t tp_gap_ms    = 300;
+  uint8_t  tp_drag      = 1;
+  uint16_t tp_lock_ms   = 800;
+  uint16_t tp_hold_ms   = 600;
+  uint16_t tp_hold2_ms  = 1200;
+  bool     tp_edge      = true;
+  // 관성(TouchInertia): 0 끔 / 1 가장자리 스크롤만 / 2 스크롤 + 커서 글라이드
+  //  - 속도 v(셀/s)는 τ(ms) 시정수로 감쇠, tp_in_stop 미만이면 정지
+  uint8_t  tp_inertia   = 0;
+  uint16_t tp_in_tau_ms = 350;
+  float    tp_in_stop   = 2.0f;
   int     slider_thresh = 25;
   int     zoom_step_dv  = 150;
   int     wheel_step_dv = 40;
   uint8_t initial_mode  = SL_WHEEL;
+  uint8_t wheel_axis    = WHEEL_VERTICAL;   // 휠 모드: 세로 휠 / 가로(AC Pan)
+
+  // 슬라이더 적응형 처리(SliderStage): 중앙값 + 학습 노이즈 바닥(상한 slider_thresh) + 속도 이득
+  //  - 이득은 zstep/wstep(이득 1 기준 스텝)을 속도에 따라 나눔: 느리면 gLo, 빠르면 gHi
+  bool     sl_adapt     = false;
+  uint16_t sl_v_lo      = 200;       // 카운트/s
+  uint16_t sl_v_hi      = 2500;      // 카운트/s
+  float    sl_g_lo      = 0.5f;
+  float    sl_g_hi      = 3.0f;
+
+  // 게임패드 응답 곡선(변경 시 LUT 재생성)
+  float   joy_deadzone  = 0.15f;     // 반경 데드존 0..0.95
+  float   joy_gamma     = 1.4f;
+  bool    joy_autocal   = true;      // 스틱 min/max/center 온라인 자동 보정
+
+  // 필터 단계(1€: 최소 컷오프 Hz, beta, 미분 컷오프 Hz)
+  //  - 게임패드: 0 = EMA(기존), 1 = 1€ (정규화 축 단위)
+  //  - 터치패드: 0 = 없음(기존), 1 = 1€ (셀 좌표 단위)
+  uint8_t joy_filter    = 0;
+  float   joy_f_min     = 2.0f;
+  float   joy_f_beta    = 1.0f;
+  float   joy_f_dc      = 1.0f;
+  uint8_t tp_filter     = 0;
+  float   tp_f_min      = 1.5f;
+  float   tp_f_beta     = 0.3f;
+  float   tp_f_dc       = 1.0f;
+
+  // 입력 스케줄러(250/500/1000 Hz) + 파이프라인 분주비
+  uint16_t input_hz     = 500;
+  uint8_t  div_gesture  = 2;
+  uint8_t  div_touch    = 2;
+  uint8_t  div_slider   = 2;
+  uint8_t  div_gamepad  = 1;
+
+  // ADC 샘플링(0: OneShot, 1: Continuous DMA) + 채널당 오버샘플 + 축약(0 avg/1 median/2 trimmed)
+  uint8_t  adc_mode     = 1;
+  uint8_t  adc_os       = 8;
+  uint8_t  adc_reduce   = 2;
+
+  // 버튼 디바운스(ms, 0 = 즉시). eager: 누름 즉시 반영 + 뗌만 디바운스
+  uint16_t deb_press_ms   = 5;
+  uint16_t deb_release_ms = 10;
+  bool     deb_eager      = false;
+
+  // USB HID 폴링 간격(bInterval ms: 1|2|4|8) — 열거 시 고정, 재부팅 후 적용
+  uint8_t  usb_poll_ms    = CFG_USB_POLL_MS;
+  // 게임패드 리포트 형식(false: 표준 int8 축, true: int16 축 + 16비트 트리거) — 재부팅 후 적용
+  bool     pad_hires      = CFG_PAD_HIRES;
+  // 게임패드+포인터 통합 리포트(리포트 ID 하나, 프레임당 IN 전송 1회) — 재부팅 후 적용
+  bool     usb_combined   = CFG_USB_COMBINED;
+  // 키보드 탭 최대 속도(탭/초, 0 = 제한 없음) — 즉시 적용
+  uint16_t kbd_tap_hz     = CFG_KBD_TAP_HZ;
 
   // 하프틱
   bool    haptics_on    = true;
@@ -48,13 +135,84 @@ struct Config {
 extern const char* KEY_VER;
 extern const char* KEY_GAIN;
 extern const char* KEY_SLTH;
+extern const char* KEY_PACC;     // ptr_accel
+extern const char* KEY_PAMIN;    // ptr_acc_min
+extern const char* KEY_PAMAX;    // ptr_acc_max
+extern const char* KEY_PAV;      // ptr_acc_v
+extern const char* KEY_PAEXP;    // ptr_acc_exp
+extern const char* KEY_TPTAP;    // tp_tap_mode
+extern const char* KEY_TPTMS;    // tp_tap_ms
+extern const char* KEY_TPGAP;    // tp_gap_ms
+extern const char* KEY_TPDRG;    // tp_drag
+extern const char* KEY_TPLKM;    // tp_lock_ms
+extern const char* KEY_TPHLD;    // tp_hold_ms
+extern const char* KEY_TPHL2;    // tp_hold2_ms
+extern const char* KEY_TPEDG;    // tp_edge
+extern const char* KEY_TPIN;     // tp_inertia
+extern const char* KEY_TPITAU;   // tp_in_tau_ms
+extern const char* KEY_TPISTP;   // tp_in_stop
 extern const char* KEY_ZSTEP;
 extern const char* KEY_WSTEP;
 extern const char* KEY_MODE;
+extern const char* KEY_WHAX;     // wheel_axis
+extern const char* KEY_SLADP;    // sl_adapt
+extern const char* KEY_SLVLO;    // sl_v_lo
+extern const char* KEY_SLVHI;    // sl_v_hi
+extern const char* KEY_SLGLO;    // sl_g_lo
+extern const char* KEY_SLGHI;    // sl_g_hi
+extern const char* KEY_JDZ;      // joy_deadzone
+extern const char* KEY_JGAM;     // joy_gamma
+extern const char* KEY_JAC;      // joy_autocal
+extern const char* KEY_JFLT;     // joy_filter
+extern const char* KEY_JFMIN;    // joy_f_min
+extern const char* KEY_JFBETA;   // joy_f_beta
+extern const char* KEY_JFDC;     // joy_f_dc
+extern const char* KEY_TFLT;     // tp_filter
+extern const char* KEY_TFMIN;    // tp_f_min
+extern const char* KEY_TFBETA;   // tp_f_beta
+extern const char* KEY_TFDC;     // tp_f_dc
+extern const char* KEY_STKCAL;   // 스틱 보정값 blob(StickCal)
+extern const char* KEY_INHZ;     // input_hz
+extern const char* KEY_DIVG;     // div_gesture
+extern const char* KEY_DIVT;     // div_touch
+extern const char* KEY_DIVS;     // div_slider
+extern const char* KEY_DIVP;     // div_gamepad
+extern const char* KEY_ADCM;     // adc_mode
+extern const char* KEY_ADCOS;    // adc_os
+extern const char* KEY_ADCRD;    // adc_reduce
+extern const char* KEY_DEBP;     // deb_press_ms
+extern const char* KEY_DEBR;     // deb_release_ms
+extern const char* KEY_DEBE;     // deb_eager
+extern const char* KEY_USBPI;    // usb_poll_ms
+extern const char* KEY_PADHR;    // pad_hires
+extern const char* KEY_USBCMB;   // usb_combined
+extern const char* KEY_KBDHZ;    // kbd_tap_hz
 extern const char* KEY_HAPT;     // on/off
 extern const char* KEY_ERMPCT;   // erm_min_pct
 extern const char* KEY_LOGMASK;  // log mask
 
+// 스틱 보정값(자동 보정 결과) — 설정과 별도 blob으로 저장
+// 축 순서: raw LX, LY, RX, RY
+struct StickCal {
+  uint8_t  ver = 0;
+  uint8_t  axes = 0;
+  uint16_t minV[4] = {0};
+  uint16_t cenV[4] = {0};
+  uint16_t maxV[4] = {0};
+};
+inline constexpr uint8_t STICKCAL_VER = 1;
+
+// blob 로드(없거나 버전/크기 불일치면 false)
+bool loadStickCal(StickCal& out);
+
+// 쓰기 코얼레싱: 스테이징만 하고 실제 NVS 쓰기는 service()에서
+//  - 마지막 변경 후 STAGE_SETTLE_MS 동안 추가 변경이 없고
+//  - 직전 쓰기 후 STAGE_MIN_INTERVAL_MS 이상 지났을 때 1회 기록
+// 입력 태스크에서 호출해도 안전(짧은 임계구역 복사만 수행)
+void stageStickCal(const StickCal& cal);
+void service(uint32_t now_ms);   // loop()에서 주기 호출
+void flushStaged();              // 대기 중인 쓰기를 즉시 기록(CLI/종료 전)
+
 // 전역 상태
 void setHooks(IRuntimeHooks* hooks);
 
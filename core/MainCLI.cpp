@@ -7,6 +7,13 @@
 #include "../haptics/HapticsRuntime.h"
 #include "../haptics/HapticsPolicy.h"
 #include "../factory/FactoryTests.h"
+#include "../input/InputScheduler.h"
+#include "../input/ButtonDebouncer.h"
+#include "../input/StickAutoCal.h"
+#include "../input/GamepadPipeline.h"
+#include "../input/TouchPadPipeline.h"
+#include "../input/SliderPipeline.h"
+#include "../usb/USBDevices.h"
 
 using namespace ConfigStore;
 
@@ -46,6 +53,90 @@ static bool parseFloat(const String& s, float& out) {
 static void printOk(const char* msg){ Serial.println(msg); }
 static void printErr(const char* msg){ Serial.println(msg); }
 
+// 디바운스 카운터는 4비트(MAX_TICKS) → 표현 가능한 최대 ms는 입력 주기에 따라 달라짐
+static uint16_t debMaxMs(uint16_t hz) {
+  return static_cast<uint16_t>((uint32_t)Debounce::MAX_TICKS * 1000u / (hz ? hz : 1));
+}
+static void printDebounce(const char* key, uint16_t ms, uint16_t hz) {
+  const uint8_t t = Debounce::msToTicks(ms, hz);
+  Serial.printf("[CLI] %s=%u ms (%u ticks @%u Hz, max %u ms)\n",
+                key, (unsigned)ms, (unsigned)t, (unsigned)hz, (unsigned)debMaxMs(hz));
+}
+
+static void printSchedStats() {
+  InputScheduler::Stats st;
+  InputScheduler::getStats(st);
+  Serial.printf("[SCHED] %uHz periods=%lu overruns=%lu missed=%lu maxJitter=%luus busy(last/max)=%lu/%luus%s\n",
+                (unsigned)st.rateHz, (unsigned long)st.periods, (unsigned long)st.overruns,
+                (unsigned long)st.missed, (unsigned long)st.maxJitterUs,
+                (unsigned long)st.lastBusyUs, (unsigned long)st.maxBusyUs,
+                InputScheduler::isSuspended() ? " (suspended)" : "");
+  Serial.print("[SCHED] jitter hist:");
+  for (uint8_t i = 0; i < InputScheduler::JITTER_BINS; ++i) {
+    if (i < InputScheduler::JITTER_BINS - 1)
+      Serial.printf(" <%u:%lu", (unsigned)InputScheduler::kJitterEdgesUs[i], (unsigned long)st.hist[i]);
+    else
+      Serial.printf(" >=%u:%lu", (unsigned)InputScheduler::kJitterEdgesUs[i-1], (unsigned long)st.hist[i]);
+  }
+  Serial.println();
+}
+
+static void printStickCal() {
+  const ConfigStore::StickCal& c = StickAutoCal::current();
+  static const char* kAxis[] = { "LX", "LY", "RX", "RY" };
+  Serial.printf("[CAL] autocal=%s\n", StickAutoCal::enabled() ? "on" : "off");
+  for (uint8_t i = 0; i < StickAutoCal::AXES; ++i) {
+    Serial.printf("[CAL] %s min=%u center=%u max=%u\n", kAxis[i],
+                  (unsigned)c.minV[i], (unsigned)c.cenV[i], (unsigned)c.maxV[i]);
+  }
+}
+
+static void printFilters() {
+  float g[4], t[2];
+  Gamepad::filterCutoffs(g);
+  TouchPad::filterCutoffs(t);
+  if (Gamepad::filterMode() == OneEuro::MODE_ONE_EURO)
+    Serial.printf("[FILTER] joy=1e fc(Hz) LX=%.2f LY=%.2f RX=%.2f RY=%.2f\n", g[0], g[1], g[2], g[3]);
+  else
+    Serial.println("[FILTER] joy=ema (alpha=0.25)");
+  if (TouchPad::filterMode() == OneEuro::MODE_ONE_EURO)
+    Serial.printf("[FILTER] tp=1e fc(Hz) X=%.2f Y=%.2f\n", t[0], t[1]);
+  else
+    Serial.println("[FILTER] tp=off");
+  Serial.printf("[FILTER] ptr accel=%s speed=%.1f cells/s mult=%.2f\n", s_cfg->ptr_accel ? "on" : "off",
+                PointerBallistics::speed(), PointerBallistics::multiplier());
+}
+
+static void printSliderStage() {
+  Slider::StageInfo si;
+  Slider::getStageInfo(si);
+  Serial.printf("[SLIDER] mode=%s adapt=%s", (Slider::getMode() == Slider::Mode::Zoom ? "zoom" : "wheel"),
+                si.adaptive ? "on" : "off");
+  if (si.adaptive)
+    Serial.printf(" floor=%.1f vel=%.0f/s gain=%.2f", si.floor, si.velocity, si.gain);
+  Serial.println();
+}
+
+static void printUsbStats() {
+  static const char* kItf[] = { "mouse", "kbd", "pad" };
+  Serial.printf("[USB] %s poll=%ums pad=%s wheelMul=%u panMul=%u\n",
+                USBDev::ready() ? "mounted" : "not mounted/suspended", (unsigned)USBDev::pollMs(),
+                USBDev::combined() ? "combo(pad+pointer)" : (USBDev::gamepadHiRes() ? "hires16" : "std8"),
+                (unsigned)USBDev::wheelMultiplier(), (unsigned)USBDev::panMultiplier());
+  for (uint8_t i = 0; i < (uint8_t)USBDev::Itf::COUNT; ++i) {
+    USBDev::TxStats st;
+    USBDev::getTxStats((USBDev::Itf)i, st);
+    Serial.printf("[USB] %-5s rate=%uHz queued=%lu merged=%lu dropped=%lu sent=%lu pending=%u\n", kItf[i],
+                  (unsigned)st.rateHz, (unsigned long)st.queued, (unsigned long)st.merged,
+                  (unsigned long)st.dropped, (unsigned long)st.sent, (unsigned)st.pending);
+  }
+  USBDev::TapStats ts;
+  USBDev::getTapStats(ts);
+  Serial.printf("[USB] taps limit=%u/s depth=%u max=%u taps=%lu cancelled=%lu overflow=%lu\n",
+                (unsigned)USBDev::keyTapRate(), (unsigned)ts.depth, (unsigned)ts.maxDepth,
+                (unsigned long)ts.taps, (unsigned long)ts.cancelled, (unsigned long)ts.overflow);
+}
+
 // ---- 공개 API ----
 void begin(Config* cfg) {
   s_cfg = cfg;
@@ -55,6 +146,28 @@ void help() {
   Serial.println(F("[CLI] commands:"));
   Serial.println(F("  cfg show|load|save|reset"));
   Serial.println(F("  cfg set gain <float> | slth <int> | zstep <int> | wstep <int> | mode <wheel|zoom|0|1>"));
+  Serial.println(F("  cfg set pacc <on|off> | pamin|pamax <mult> | pav <cells/s> | paexp <0.2..5>  (cursor accel curve)"));
+  Serial.println(F("  cfg set whax <vertical|pan>   (slider wheel axis)"));
+  Serial.println(F("  cfg set tptap <off|tap|double> | tpdrg <off|drag|lock> | tpedg <on|off>  (touch gestures)"));
+  Serial.println(F("  cfg set tptms|tpgap|tplkm|tphld|tphl2 <ms>   (tap/gap/drag-lock/hold/hold-cancel)"));
+  Serial.println(F("  cfg set tpin <off|scroll|all> | tpitau <50..3000 ms> | tpistp <cells/s>  (touch inertia)"));
+  Serial.println(F("  cfg set sladp <on|off> | slvlo|slvhi <counts/s> | slglo|slghi <0..20>  (adaptive slider)"));
+  Serial.println(F("  cfg set jdz <0..0.95> | jgam <float>   (stick curve, LUT rebuild)"));
+  Serial.println(F("  cfg set inhz <250|500|1000> | divg|divt|divs|divp <1..255>  (input rate/dividers)"));
+  Serial.println(F("  cfg set adcm <oneshot|dma> | adcos <1..16> | adcrd <avg|median|trimmed>  (ADC sampling)"));
+  Serial.println(F("  cfg set debp|debr <ms, max 15 ticks: 60@250Hz 30@500Hz 15@1000Hz> | debe <on|off>  (button debounce)"));
+  Serial.println(F("  cfg set usbpi <1|2|4|8>   (USB HID poll interval ms, save+reboot)"));
+  Serial.println(F("  cfg set padhr <on|off>    (16-bit gamepad axes + triggers, save+reboot)"));
+  Serial.println(F("  cfg set usbcmb <on|off>   (raw/evdev only: one gamepad+pointer report, no OS cursor, save+reboot)"));
+  Serial.println(F("  cfg set kbdhz <0..1000>   (max keyboard taps/s, 0 = one per flush)"));
+  Serial.println(F("  cfg set jac <on|off>   (stick online auto-calibration)"));
+  Serial.println(F("  cfg set jflt <ema|1e> | tflt <off|1e>   (stick / touch filter)"));
+  Serial.println(F("  cfg set jfmin|jfbeta|jfdc|tfmin|tfbeta|tfdc <float>   (One-Euro params)"));
+  Serial.println(F("  sched show|reset       (input scheduler overruns & jitter)"));
+  Serial.println(F("  filter show            (effective One-Euro cutoff)"));
+  Serial.println(F("  slider show            (adaptive slider noise floor/velocity/gain)"));
+  Serial.println(F("  usb show|reset         (HID report rate & send queue counters)"));
+  Serial.println(F("  cal show|reset|save    (stick calibration)"));
   Serial.println(F("  haptics on|off"));
   Serial.println(F("  hap min <pct 0..100>"));
   Serial.println(F("  log set <mask(0x..|dec)>"));
@@ -127,6 +240,80 @@ void poll() {
       Serial.printf("[CLI] gain=%.2f\n", s_cfg->cursor_gain);
       return;
     }
+    if (key == "pacc") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->ptr_accel = true;
+      else if (v == "off" || v == "0") s_cfg->ptr_accel = false;
+      else { printErr("[CLI] pacc must be on|off|0|1"); return; }
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] pacc=%s\n", s_cfg->ptr_accel ? "on" : "off");
+      return;
+    }
+    if (key == "pamin" || key == "pamax" || key == "pav" || key == "paexp") {
+      float f;
+      const float lo = (key == "paexp") ? 0.2f : 0.0f;
+      const float hi = (key == "paexp") ? 5.0f : (key == "pav") ? 1000.0f : 20.0f;
+      if (!parseFloat(val, f) || !(f > lo) || f > hi) { Serial.printf("[CLI] %s must be a float (%.1f..%.1f]\n", key.c_str(), lo, hi); return; }
+      float& d = (key == "pamin") ? s_cfg->ptr_acc_min : (key == "pamax") ? s_cfg->ptr_acc_max :
+                 (key == "pav")   ? s_cfg->ptr_acc_v   : s_cfg->ptr_acc_exp;
+      d = f;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] %s=%.2f\n", key.c_str(), d);
+      return;
+    }
+    if (key == "tptap" || key == "tpdrg") {
+      String v = val; v.toLowerCase();
+      const bool tap = (key == "tptap");
+      uint8_t m = (v == "off" || v == "0") ? 0 :
+                  (v == (tap ? "tap" : "drag")   || v == "1") ? 1 :
+                  (v == (tap ? "double" : "lock") || v == "2") ? 2 : 255;
+      if (m == 255) { Serial.printf("[CLI] %s must be %s\n", key.c_str(), tap ? "off|tap|double|0|1|2" : "off|drag|lock|0|1|2"); return; }
+      (tap ? s_cfg->tp_tap_mode : s_cfg->tp_drag) = m;
+      Serial.printf("[CLI] %s=%u\n", key.c_str(), m);
+      return;
+    }
+    if (key == "tptms" || key == "tpgap" || key == "tplkm" || key == "tphld" || key == "tphl2") {
+      int v;
+      const int lo = (key == "tptms" || key == "tpgap") ? 50 : 0;
+      const int hi = (key == "tplkm") ? 5000 : (key == "tphl2") ? 2499 : (key == "tphld") ? 2000 : 1000;
+      if (!parseInt(val, v) || v < lo || v > hi) { Serial.printf("[CLI] %s must be an int %d..%d ms\n", key.c_str(), lo, hi); return; }
+      uint16_t& d = (key == "tptms") ? s_cfg->tp_tap_ms  : (key == "tpgap") ? s_cfg->tp_gap_ms :
+                    (key == "tplkm") ? s_cfg->tp_lock_ms : (key == "tphld") ? s_cfg->tp_hold_ms : s_cfg->tp_hold2_ms;
+      d = (uint16_t)v;
+      if (s_cfg->tp_hold_ms && s_cfg->tp_hold2_ms <= s_cfg->tp_hold_ms) printErr("[CLI] warn: tphl2 <= tphld (hold right-click cancels immediately)");
+      Serial.printf("[CLI] %s=%u ms\n", key.c_str(), (unsigned)d);
+      return;
+    }
+    if (key == "tpin") {
+      String v = val; v.toLowerCase();
+      uint8_t m = (v == "off" || v == "0") ? 0 : (v == "scroll" || v == "1") ? 1 : (v == "all" || v == "2") ? 2 : 255;
+      if (m == 255) { printErr("[CLI] tpin must be off|scroll|all|0|1|2"); return; }
+      s_cfg->tp_inertia = m;
+      Serial.printf("[CLI] tpin=%u\n", m);
+      return;
+    }
+    if (key == "tpitau") {
+      int v;
+      if (!parseInt(val, v) || v < 50 || v > 3000) { printErr("[CLI] tpitau must be an int 50..3000 ms"); return; }
+      s_cfg->tp_in_tau_ms = (uint16_t)v;
+      Serial.printf("[CLI] tpitau=%u ms\n", (unsigned)s_cfg->tp_in_tau_ms);
+      return;
+    }
+    if (key == "tpistp") {
+      float f;
+      if (!parseFloat(val, f) || f < 0.1f || f > 50.0f) { printErr("[CLI] tpistp must be a float 0.1..50 cells/s"); return; }
+      s_cfg->tp_in_stop = f;
+      Serial.printf("[CLI] tpistp=%.2f\n", s_cfg->tp_in_stop);
+      return;
+    }
+    if (key == "tpedg") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->tp_edge = true;
+      else if (v == "off" || v == "0") s_cfg->tp_edge = false;
+      else { printErr("[CLI] tpedg must be on|off|0|1"); return; }
+      Serial.printf("[CLI] tpedg=%s\n", s_cfg->tp_edge ? "on" : "off");
+      return;
+    }
     if (key == "slth") {
       int v;
       if (!parseInt(val, v)) { printErr("[CLI] slth must be an int"); return; }
@@ -160,8 +347,219 @@ void poll() {
       Serial.printf("[CLI] mode=%s\n", (s_cfg->initial_mode==SL_ZOOM?"zoom":"wheel"));
       return;
     }
+    if (key == "whax") {
+      uint8_t a = (val=="pan"     || val=="1") ? WHEEL_PAN :
+                  (val=="vertical"|| val=="v" || val=="0") ? WHEEL_VERTICAL : 255;
+      if (a == 255) { printErr("[CLI] whax must be vertical|pan|0|1"); return; }
+      s_cfg->wheel_axis = a;
+      Serial.printf("[CLI] whax=%s\n", (s_cfg->wheel_axis==WHEEL_PAN?"pan":"vertical"));
+      return;
+    }
+
+    if (key == "jdz") {
+      float f;
+      if (!parseFloat(val, f) || f < 0.0f || f > 0.95f) { printErr("[CLI] jdz must be a float 0..0.95"); return; }
+      s_cfg->joy_deadzone = f;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] jdz=%.2f\n", s_cfg->joy_deadzone);
+      return;
+    }
+    if (key == "jgam") {
+      float f;
+      if (!parseFloat(val, f) || f < 0.2f || f > 4.0f) { printErr("[CLI] jgam must be a float 0.2..4.0"); return; }
+      s_cfg->joy_gamma = f;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] jgam=%.2f\n", s_cfg->joy_gamma);
+      return;
+    }
+
+    if (key == "sladp") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->sl_adapt = true;
+      else if (v == "off" || v == "0") s_cfg->sl_adapt = false;
+      else { printErr("[CLI] sladp must be on|off|0|1"); return; }
+      Serial.printf("[CLI] sladp=%s\n", s_cfg->sl_adapt ? "on" : "off");
+      return;
+    }
+    if (key == "slvlo" || key == "slvhi") {
+      int v;
+      if (!parseInt(val, v) || v < 0 || v > 60000) { printErr("[CLI] slvlo/slvhi must be 0..60000 counts/s"); return; }
+      const bool lo = (key == "slvlo");
+      if (lo ? (v >= s_cfg->sl_v_hi) : (v <= s_cfg->sl_v_lo)) { printErr("[CLI] need slvlo < slvhi"); return; }
+      (lo ? s_cfg->sl_v_lo : s_cfg->sl_v_hi) = (uint16_t)v;
+      Serial.printf("[CLI] %s=%d\n", key.c_str(), v);
+      return;
+    }
+    if (key == "slglo" || key == "slghi") {
+      float f;
+      if (!parseFloat(val, f) || !(f > 0.0f) || f > 20.0f) { printErr("[CLI] slglo/slghi must be a float 0..20"); return; }
+      float& d = (key == "slglo") ? s_cfg->sl_g_lo : s_cfg->sl_g_hi;
+      d = f;
+      Serial.printf("[CLI] %s=%.2f\n", key.c_str(), d);
+      return;
+    }
+    if (key == "jac") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->joy_autocal = true;
+      else if (v == "off" || v == "0") s_cfg->joy_autocal = false;
+      else { printErr("[CLI] jac must be on|off|0|1"); return; }
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] jac=%s\n", s_cfg->joy_autocal ? "on" : "off");
+      return;
+    }
 
-    printErr("[CLI] unknown key (gain|slth|zstep|wstep|mode)");
+    if (key == "jflt" || key == "tflt") {
+      String v = val; v.toLowerCase();
+      uint8_t m;
+      if      (v == "1e" || v == "1") m = 1;
+      else if ((key == "jflt" && v == "ema") || (key == "tflt" && v == "off") || v == "0") m = 0;
+      else { printErr(key == "jflt" ? "[CLI] jflt must be ema|1e|0|1" : "[CLI] tflt must be off|1e|0|1"); return; }
+      (key == "jflt" ? s_cfg->joy_filter : s_cfg->tp_filter) = m;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] %s=%u\n", key.c_str(), (unsigned)m);
+      return;
+    }
+    if (key == "jfmin" || key == "jfdc" || key == "tfmin" || key == "tfdc") {
+      float f;
+      if (!parseFloat(val, f) || f < 0.01f || f > 30.0f) { printErr("[CLI] cutoff must be a float 0.01..30 Hz"); return; }
+      float& d = (key == "jfmin") ? s_cfg->joy_f_min :
+                 (key == "jfdc")  ? s_cfg->joy_f_dc  :
+                 (key == "tfmin") ? s_cfg->tp_f_min  : s_cfg->tp_f_dc;
+      d = f;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] %s=%.2f\n", key.c_str(), d);
+      return;
+    }
+    if (key == "jfbeta" || key == "tfbeta") {
+      float f;
+      if (!parseFloat(val, f) || f < 0.0f || f > 100.0f) { printErr("[CLI] beta must be a float 0..100"); return; }
+      float& d = (key == "jfbeta") ? s_cfg->joy_f_beta : s_cfg->tp_f_beta;
+      d = f;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] %s=%.3f\n", key.c_str(), d);
+      return;
+    }
+
+    if (key == "inhz") {
+      int v;
+      if (!parseInt(val, v) || (v != 250 && v != 500 && v != 1000)) { printErr("[CLI] inhz must be 250|500|1000"); return; }
+      s_cfg->input_hz = static_cast<uint16_t>(v);
+      // 주기가 올라가면 디바운스 상한이 줄어듦 → 저장값도 새 상한으로 맞춤
+      const uint16_t dmax = debMaxMs(s_cfg->input_hz);
+      const bool dclamp = s_cfg->deb_press_ms > dmax || s_cfg->deb_release_ms > dmax;
+      if (s_cfg->deb_press_ms   > dmax) s_cfg->deb_press_ms   = dmax;
+      if (s_cfg->deb_release_ms > dmax) s_cfg->deb_release_ms = dmax;
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] inhz=%u\n", (unsigned)s_cfg->input_hz);
+      if (dclamp) {
+        printDebounce("debp", s_cfg->deb_press_ms, s_cfg->input_hz);
+        printDebounce("debr", s_cfg->deb_release_ms, s_cfg->input_hz);
+      }
+      return;
+    }
+    if (key == "divg" || key == "divt" || key == "divs" || key == "divp") {
+      int v;
+      if (!parseInt(val, v) || v < 1 || v > 255) { printErr("[CLI] divider must be 1..255"); return; }
+      uint8_t& d = (key == "divg") ? s_cfg->div_gesture :
+                   (key == "divt") ? s_cfg->div_touch   :
+                   (key == "divs") ? s_cfg->div_slider  : s_cfg->div_gamepad;
+      d = static_cast<uint8_t>(v);
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] %s=%u\n", key.c_str(), (unsigned)d);
+      return;
+    }
+
+    if (key == "adcm") {
+      String v = val; v.toLowerCase();
+      if      (v == "oneshot" || v == "0") s_cfg->adc_mode = 0;
+      else if (v == "dma"     || v == "1") s_cfg->adc_mode = 1;
+      else { printErr("[CLI] adcm must be oneshot|dma|0|1"); return; }
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] adcm=%s\n", s_cfg->adc_mode ? "dma" : "oneshot");
+      return;
+    }
+    if (key == "adcos") {
+      int v;
+      if (!parseInt(val, v) || v < 1 || v > 16) { printErr("[CLI] adcos must be 1..16"); return; }
+      s_cfg->adc_os = static_cast<uint8_t>(v);
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] adcos=%u\n", (unsigned)s_cfg->adc_os);
+      return;
+    }
+    if (key == "adcrd") {
+      String v = val; v.toLowerCase();
+      if      (v == "avg"     || v == "0") s_cfg->adc_reduce = 0;
+      else if (v == "median"  || v == "1") s_cfg->adc_reduce = 1;
+      else if (v == "trimmed" || v == "2") s_cfg->adc_reduce = 2;
+      else { printErr("[CLI] adcrd must be avg|median|trimmed|0..2"); return; }
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] adcrd=%u\n", (unsigned)s_cfg->adc_reduce);
+      return;
+    }
+
+    if (key == "debp" || key == "debr") {
+      int v;
+      // 상한은 현재 입력 주기 기준(15틱): 1000Hz=15ms, 500Hz=30ms, 250Hz=60ms
+      const uint16_t hz   = s_cfg->input_hz;
+      const uint16_t dmax = debMaxMs(hz);
+      if (!parseInt(val, v) || v < 0 || v > dmax) {
+        Serial.printf("[CLI] debounce must be 0..%u ms at %u Hz\n", (unsigned)dmax, (unsigned)hz);
+        return;
+      }
+      uint16_t& d = (key == "debp") ? s_cfg->deb_press_ms : s_cfg->deb_release_ms;
+      d = static_cast<uint16_t>(v);
+      ConfigStore::applyToRuntime(*s_cfg);
+      printDebounce(key.c_str(), d, hz);
+      return;
+    }
+    if (key == "debe") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->deb_eager = true;
+      else if (v == "off" || v == "0") s_cfg->deb_eager = false;
+      else { printErr("[CLI] debe must be on|off|0|1"); return; }
+      ConfigStore::applyToRuntime(*s_cfg);
+      Serial.printf("[CLI] debe=%s\n", s_cfg->deb_eager ? "on" : "off");
+      return;
+    }
+    if (key == "usbpi") {
+      int v;
+      if (!parseInt(val, v) || (v != 1 && v != 2 && v != 4 && v != 8)) { printErr("[CLI] usbpi must be 1|2|4|8"); return; }
+      s_cfg->usb_poll_ms = static_cast<uint8_t>(v);
+      Serial.printf("[CLI] usbpi=%u ms (cfg save + reboot to apply, now %u ms)\n",
+                    (unsigned)s_cfg->usb_poll_ms, (unsigned)USBDev::pollMs());
+      return;
+    }
+    if (key == "padhr") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->pad_hires = true;
+      else if (v == "off" || v == "0") s_cfg->pad_hires = false;
+      else { printErr("[CLI] padhr must be on|off|0|1"); return; }
+      Serial.printf("[CLI] padhr=%s (cfg save + reboot to apply, now %s)\n",
+                    s_cfg->pad_hires ? "on" : "off", USBDev::gamepadHiRes() ? "on" : "off");
+      return;
+    }
+    if (key == "usbcmb") {
+      String v = val; v.toLowerCase();
+      if      (v == "on"  || v == "1") s_cfg->usb_combined = true;
+      else if (v == "off" || v == "0") s_cfg->usb_combined = false;
+      else { printErr("[CLI] usbcmb must be on|off|0|1"); return; }
+      Serial.printf("[CLI] usbcmb=%s (cfg save + reboot to apply, now %s)\n",
+                    s_cfg->usb_combined ? "on" : "off", USBDev::combined() ? "on" : "off");
+      if (s_cfg->usb_combined)
+        Serial.println("[CLI] note: no mouse report ID in this mode - OS mouse drivers will not move the cursor");
+      return;
+    }
+
+    if (key == "kbdhz") {
+      int v;
+      if (!parseInt(val, v) || v < 0 || v > 1000) { printErr("[CLI] kbdhz must be 0..1000 (0 = no limit)"); return; }
+      s_cfg->kbd_tap_hz = (uint16_t)v;
+      USBDev::setKeyTapRate(s_cfg->kbd_tap_hz);
+      Serial.printf("[CLI] kbdhz=%u taps/s\n", (unsigned)s_cfg->kbd_tap_hz);
+      return;
+    }
+
+    printErr("[CLI] unknown key (gain|pacc|pamin|pamax|pav|paexp|tptap|tptms|tpgap|tpdrg|tplkm|tphld|tphl2|tpedg|tpin|tpitau|tpistp|slth|zstep|wstep|mode|whax|sladp|slvlo|slvhi|slglo|slghi|jdz|jgam|jac|jflt|jfmin|jfbeta|jfdc|tflt|tfmin|tfbeta|tfdc|inhz|divg|divt|divs|divp|adcm|adcos|adcrd|debp|debr|debe|usbpi|padhr|usbcmb|kbdhz)");
     return;
   }
 
@@ -213,6 +611,56 @@ void poll() {
     return;
   }
 
+  // ---- sched show|reset ----
+  if (line == "sched show") {
+    printSchedStats();
+    return;
+  }
+  if (line == "sched reset") {
+    InputScheduler::resetStats();
+    printOk("[CLI] sched stats reset");
+    return;
+  }
+
+  // ---- usb show|reset ----
+  if (line == "usb show") {
+    printUsbStats();
+    return;
+  }
+  if (line == "usb reset") {
+    USBDev::resetTxStats();
+    printOk("[CLI] usb stats reset");
+    return;
+  }
+
+  // ---- slider show ----
+  if (line == "slider show") {
+    printSliderStage();
+    return;
+  }
+
+  // ---- filter show ----
+  if (line == "filter show") {
+    printFilters();
+    return;
+  }
+
+  // ---- cal show|reset|save ----
+  if (line == "cal show") {
+    printStickCal();
+    return;
+  }
+  if (line == "cal reset") {
+    Gamepad::resetCalibration();
+    printOk("[CLI] stick cal reset to defaults (re-learning)");
+    return;
+  }
+  if (line == "cal save") {
+    ConfigStore::flushStaged();
+    printOk("[CLI] stick cal flushed");
+    return;
+  }
+
   // ---- factory smoke|full ----
   if (line == "factory smoke") {
     FactoryTests::runFactory(FactoryTests::Profile::SMOKE);
@@ -0,0 +1,148 @@
+//
+// stick_shaping_bench.cpp — 호스트 전용 마이크로벤치 (float 기준 경로 vs Q15 고정소수점 경로)
+//  - 정확도: 입력 격자/랜덤 시퀀스에서 int8 출력 차이(LSB) 최대값/분포
+//  - 성능: 스틱 1개 기준 정규화→EMA→셰이핑→int8 1회 평균 ns
+//
+//  빌드(리포 루트에서):
+//    g++ -std=c++17 -O2 -DCOMBOPAD_HOST_BENCH -I. extras/bench/stick_shaping_bench.cpp -o /tmp/stick_bench
+//    /tmp/stick_bench
+//
+//  펌웨어 빌드에는 포함되지 않음(COMBOPAD_HOST_BENCH 가드)
+//
+
+#if defined(COMBOPAD_HOST_BENCH)
+
+#include "input/StickShaping.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace StickShaping;
+
+namespace {
+
+constexpr int   MIN_V = 300, CEN_V = 2048, MAX_V = 3800;
+constexpr float EMA_A = 0.25f;
+
+struct Diff {
+  long n = 0, off1 = 0, off2 = 0;
+  int  maxAbs = 0;
+  void add(int a, int b){
+    const int d = abs(a - b);
+    ++n;
+    if (d == 1) ++off1;
+    if (d >= 2) ++off2;
+    if (d > maxAbs) maxAbs = d;
+  }
+};
+
+// 1) 정규화된 입력 격자(x,y ∈ [-1,1])에서 셰이핑만 비교
+void gridShape(Diff& d){
+  const int N = 1024;
+  for (int i = 0; i <= N; ++i){
+    for (int j = 0; j <= N; ++j){
+      const float fx = -1.f + 2.f * i / N;
+      const float fy = -1.f + 2.f * j / N;
+      float rx = fx, ry = fy;
+      Ref::shapeStick(rx, ry, (float)DEFAULT_DEADZONE, (float)DEFAULT_GAMMA);
+      int32_t qx = (int32_t)lroundf(fx * Q15_MAX), qy = (int32_t)lroundf(fy * Q15_MAX);
+      shapeQ15(qx, qy, kDefaultLut);
+      d.add(Ref::toI8(rx), q15ToI8(qx));
+      d.add(Ref::toI8(ry), q15ToI8(qy));
+    }
+  }
+}
+
+// 2) raw ADC 랜덤 워크 → 정규화 → EMA → 셰이핑 전체 체인 비교
+void chain(Diff& d, std::vector<int>& xs, std::vector<int>& ys){
+  AxisNorm ax; axisPrepare(ax, MIN_V, CEN_V, MAX_V);
+  float ex = 0.f, ey = 0.f;
+  int32_t qx = 0, qy = 0;
+  const int32_t aQ = (int32_t)lroundf(EMA_A * Q15_ONE);
+  for (size_t i = 0; i < xs.size(); ++i){
+    float nx = Ref::normalizeAxis(xs[i], MIN_V, CEN_V, MAX_V);
+    float ny = Ref::normalizeAxis(ys[i], MIN_V, CEN_V, MAX_V);
+    ex += EMA_A * (nx - ex); ey += EMA_A * (ny - ey);
+    float fx = ex, fy = ey;
+    Ref::shapeStick(fx, fy, (float)DEFAULT_DEADZONE, (float)DEFAULT_GAMMA);
+
+    emaQ15(aQ, normalizeQ15(xs[i], ax), qx);
+    emaQ15(aQ, normalizeQ15(ys[i], ax), qy);
+    int32_t gx = qx, gy = qy;
+    shapeQ15(gx, gy, kDefaultLut);
+
+    d.add(Ref::toI8(fx), q15ToI8(gx));
+    d.add(Ref::toI8(fy), q15ToI8(gy));
+  }
+}
+
+void makeWalk(std::vector<int>& xs, std::vector<int>& ys, size_t n){
+  srand(12345);
+  int x = CEN_V, y = CEN_V;
+  xs.resize(n); ys.resize(n);
+  for (size_t i = 0; i < n; ++i){
+    if ((rand() & 63) == 0){ x = rand() % 4096; y = rand() % 4096; } // 플릭
+    x += (rand() % 161) - 80; y += (rand() % 161) - 80;
+    x = (x < 0) ? 0 : (x > 4095) ? 4095 : x;
+    y = (y < 0) ? 0 : (y > 4095) ? 4095 : y;
+    xs[i] = x; ys[i] = y;
+  }
+}
+
+volatile int g_sink = 0;
+
+template <class F>
+double timeNs(const char* name, size_t n, F&& f){
+  const auto t0 = std::chrono::steady_clock::now();
+  f();
+  const auto t1 = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)n;
+  printf("  %-6s %8.2f ns/stick\n", name, ns);
+  return ns;
+}
+
+} // anon
+
+int main(){
+  Diff g; gridShape(g);
+  printf("[grid ] samples=%ld  |Δ|=1: %ld  |Δ|>=2: %ld  max=%d LSB\n", g.n, g.off1, g.off2, g.maxAbs);
+
+  std::vector<int> xs, ys;
+  makeWalk(xs, ys, 2000000);
+  Diff c; chain(c, xs, ys);
+  printf("[chain] samples=%ld  |Δ|=1: %ld  |Δ|>=2: %ld  max=%d LSB\n", c.n, c.off1, c.off2, c.maxAbs);
+
+  printf("[perf ] normalize+EMA+shape+int8, %zu sticks\n", xs.size());
+  const double tf = timeNs("float", xs.size(), [&]{
+    float ex = 0.f, ey = 0.f; int acc = 0;
+    for (size_t i = 0; i < xs.size(); ++i){
+      float nx = Ref::normalizeAxis(xs[i], MIN_V, CEN_V, MAX_V);
+      float ny = Ref::normalizeAxis(ys[i], MIN_V, CEN_V, MAX_V);
+      ex += EMA_A * (nx - ex); ey += EMA_A * (ny - ey);
+      float fx = ex, fy = ey;
+      Ref::shapeStick(fx, fy, (float)DEFAULT_DEADZONE, (float)DEFAULT_GAMMA);
+      acc += Ref::toI8(fx) + Ref::toI8(fy);
+    }
+    g_sink = acc;
+  });
+  const double tq = timeNs("q15", xs.size(), [&]{
+    AxisNorm ax; axisPrepare(ax, MIN_V, CEN_V, MAX_V);
+    const int32_t aQ = (int32_t)lroundf(EMA_A * Q15_ONE);
+    int32_t qx = 0, qy = 0; int acc = 0;
+    for (size_t i = 0; i < xs.size(); ++i){
+      emaQ15(aQ, normalizeQ15(xs[i], ax), qx);
+      emaQ15(aQ, normalizeQ15(ys[i], ax), qy);
+      int32_t gx = qx, gy = qy;
+      shapeQ15(gx, gy, kDefaultLut);
+      acc += q15ToI8(gx) + q15ToI8(gy);
+    }
+    g_sink = acc;
+  });
+  printf("  speedup x%.2f (호스트 FPU 기준; ESP32-S3는 powf가 소프트웨어 구현이라 격차가 더 큼)\n", tf / tq);
+
+  return (g.maxAbs <= 1 && c.maxAbs <= 1) ? 0 : 1;
+}
+
+#endif // COMBOPAD_HOST_BENCH
@@ -4,6 +4,7 @@
 #include "../haptics/HapticsRuntime.h"
 #include "../imu/IMU.h"
 #include "../usb/USBDevices.h"
+#include "../input/InputScheduler.h"
 #include "../core/Log.h"
 
 #include <math.h>
@@ -29,7 +30,8 @@ inline void ledPassHold(){
 
 // 유틸
 static int readADCavg(int pin, int n=8){
-  long acc=0; for(int i=0;i<n;i++){ acc+=analogRead(pin); delay(1); } return (int)(acc/n);
+  // Continuous 모드면 HAL 프레임이 이미 오버샘플 값 → 프레임 주기(≈1ms) 간격으로 평균
+  long acc=0; for(int i=0;i<n;i++){ acc+=HAL::readAdcPin(pin); delay(1); } return (int)(acc/n);
 }
 
 // 방향 제스처(터치 좌표 기반)
@@ -276,6 +278,10 @@ void init(){ /* 확장 포인트: 현재 NOP */ }
 Result run(Profile profile, bool interactive){
   LOGI("FACT","enter (profile=%s)", profile==Profile::Smoke?"SMOKE":"FULL");
 
+  // 테스트가 HAL을 직접 점유하므로 입력 스케줄러 일시 중지(종료 시 복원)
+  const bool schedWasRunning = !InputScheduler::isSuspended();
+  InputScheduler::suspend();
+
   // 하프틱은 항상 활성화(기존 상태 저장/복원)
   const bool prev = HapticsRuntime::isEnabled();
   HapticsRuntime::setEnabled(true);
@@ -316,8 +322,14 @@ Result run(Profile profile, bool interactive){
       uint32_t idleBlinkT=millis(); bool bOn=false;
       while(true){
         if(millis()-idleBlinkT>500){ bOn=!bOn; HAL::ledB(bOn); idleBlinkT=millis(); }
-        if (HAL::pressed(HAL::Button::A)){ return run(Profile::Smoke, false); }
-        if (HAL::pressed(HAL::Button::B)){ return run(Profile::Full,  false); }
+        // 재시도 전 상태 복원(재귀 run이 다시 저장/중지/복원)
+        const bool retrySmoke = HAL::pressed(HAL::Button::A);
+        const bool retryFull  = HAL::pressed(HAL::Button::B);
+        if (retrySmoke || retryFull){
+          HapticsRuntime::setEnabled(prev);
+          if (schedWasRunning) InputScheduler::resume();
+          return run(retrySmoke ? Profile::Smoke : Profile::Full, false);
+        }
         delay(10);
       }
     }
@@ -325,6 +337,7 @@ Result run(Profile profile, bool interactive){
 
   // 상태 복원
   HapticsRuntime::setEnabled(prev);
+  if (schedWasRunning) InputScheduler::resume();
   return res;
 }
 
@@ -1,6 +1,17 @@
 #include "HAL.h"
+#include "../core/BuildOpts.h"
 #include <mpr121.h>  // CapaTouch (MPR121)
 
+#include <atomic>
+#include "esp_adc/adc_continuous.h"
+#include "esp_timer.h"
+#include "esp32-hal-periman.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
 using namespace HAL;
 
 // 내부: 전역 객체(라이브러리 특성상 전역 인스턴스 사용)
@@ -13,6 +24,430 @@ static inline void cfgOutput(int pin)       { pinMode(pin, OUTPUT); digitalWrite
 namespace {
   // 아날로그 해상도/어텐 설정값
   constexpr uint8_t kAdcBits = 12; // 0..4095
+
+  // ---- 버튼 레지스터 매핑 ----
+  // GPIO_IN_REG: GPIO0..31, GPIO_IN1_REG: GPIO32..48
+  struct BtnMap { uint8_t gpio; Button btn; bool activeHigh; };
+  constexpr BtnMap kBtnMap[] = {
+    { (uint8_t)Pin::BTN_A,         Button::A,            false },
+    { (uint8_t)Pin::BTN_B,         Button::B,            false },
+    { (uint8_t)Pin::BTN_X,         Button::X,            false },
+    { (uint8_t)Pin::BTN_Y,         Button::Y,            false },
+    { (uint8_t)Pin::JS_L_SW,       Button::L3,           false },
+    { (uint8_t)Pin::JS_R_SW,       Button::R3,           false },
+    { (uint8_t)Pin::TOUCH_DIGITAL, Button::TouchDigital, Const::TOUCH_ACTIVE_HIGH },
+  };
+
+  // ---- MPR121 IRQ/버스트 ----
+  constexpr uint8_t MPR_REG_TOUCH = 0x00;   // 0x00..0x01 상태, 0x04..0x1B 필터, 0x1E..0x29 베이스라인
+  constexpr uint8_t MPR_REG_FILT  = 0x04;
+  constexpr uint8_t MPR_REG_BASE  = 0x1E;
+  constexpr uint8_t MPR_BURST_LEN = 0x2B;   // 0x00..0x2A
+  // IRQ는 터치 상태 변화 때만 옴 → 닿아 있는 동안은 전극 데이터(무게중심)를 추적 주기마다 추가 읽기
+  // 추적 주기 = 터치 tick 주기의 정수배(최소 TOUCH_TRACK_MIN_US), 베이스라인은 TOUCH_FULL_EVERY회마다 갱신
+  constexpr uint32_t TOUCH_TRACK_MIN_US = 5000;
+  constexpr uint8_t  TOUCH_FULL_EVERY   = 16;
+
+  // 공유 I2C 클록: MPR121/DRV2605/IMU 모두 Fast-mode(400kHz) 지원 — 43바이트 버스트 ≈1.1ms(100kHz면 ≈4.1ms)
+  constexpr uint32_t I2C_HZ = 400000;
+
+  // 터치 수집 태스크: I2C 버스트는 입력 tick 밖(코어0)에서, 결과는 seqlock으로 게시(ADC 프레임과 같은 방식)
+  constexpr uint32_t    TOUCH_TASK_STACK = 3072;
+  constexpr UBaseType_t TOUCH_TASK_PRIO  = 3;
+  constexpr BaseType_t  TOUCH_TASK_CORE  = 0;
+
+  volatile bool     s_touchIrq   = false;
+  volatile uint64_t s_touchIrqUs = 0;
+  TaskHandle_t      s_touchTask  = nullptr;
+  std::atomic<uint32_t> s_touchTrackUs{ TOUCH_TRACK_MIN_US };
+
+  // seqlock: 홀수 = 쓰는 중. 단일 writer(터치 태스크), 다중 reader
+  std::atomic<uint32_t> s_touchSeq{0};
+  TouchSample           s_touchPub;
+
+  void IRAM_ATTR onTouchIrq(){
+    s_touchIrqUs = (uint64_t)esp_timer_get_time();
+    s_touchIrq   = true;
+    BaseType_t woken = pdFALSE;
+    if (s_touchTask) vTaskNotifyGiveFromISR(s_touchTask, &woken);
+    if (woken) portYIELD_FROM_ISR();
+  }
+
+  // 축 전극 비트 → 격자 좌표(0 = 닿은 전극 없음)
+  int axisCoord(uint16_t status, uint8_t first, uint8_t count){
+    int lo = -1, hi = -1;
+    for (uint8_t i = 0; i < count; ++i){
+      if (status & (1u << (first + i))){ if (lo < 0) lo = i; hi = i; }
+    }
+    return (lo < 0) ? 0 : lo + hi + 1;
+  }
+
+  bool mprRead(uint8_t reg, uint8_t* b, uint8_t n){
+    TwoWire& w = Wire;
+    w.beginTransmission(Const::MPR121_ADDR);
+    w.write(reg);
+    if (w.endTransmission(false) != 0) return false;
+    if (w.requestFrom((uint16_t)Const::MPR121_ADDR, n) != n) return false;
+    for (uint8_t i = 0; i < n; ++i) b[i] = (uint8_t)w.read();
+    return true;
+  }
+
+  void touchFinish(TouchSample& s, uint64_t t_us){
+    s.t_us = t_us;
+    s.seq++;
+    int x = axisCoord(s.status, Const::TOUCH_X_FIRST, Const::TOUCH_X_COUNT);
+    const int y = axisCoord(s.status, Const::TOUCH_Y_FIRST, Const::TOUCH_Y_COUNT);
+    s.valid = (x >= Const::CX_MIN && x <= Const::CX_MAX && y >= Const::CY_MIN && y <= Const::CY_MAX);
+    if (s.valid){
+      x = (Const::CX_MAX + 1) - x;   // 기존 구현처럼 X축 반전(터치패드 좌우 방향 맞춤)
+      s.pt = TouchPt{ x, y };
+    }
+  }
+
+  // 0x00..0x2A 한 번에 읽어 샘플 갱신(실패 시 false, 이전 샘플 유지)
+  bool touchBurst(TouchSample& s, uint64_t t_us){
+    uint8_t b[MPR_BURST_LEN];
+    if (!mprRead(MPR_REG_TOUCH, b, MPR_BURST_LEN)) return false;
+    s.status = (uint16_t)((b[0] | (b[1] << 8)) & 0x0FFF);
+    for (uint8_t e = 0; e < Const::TOUCH_ELECTRODES; ++e){
+      s.filt[e] = (uint16_t)((b[MPR_REG_FILT + 2 * e] | (b[MPR_REG_FILT + 2 * e + 1] << 8)) & 0x03FF);
+      s.base[e] = b[MPR_REG_BASE + e];
+    }
+    touchFinish(s, t_us);
+    return true;
+  }
+
+  // 한 축에서 닿은 전극 ±1 창(무게중심이 쓰는 범위)의 끝 전극 번호+1(닿은 전극 없으면 0)
+  uint8_t windowEnd(uint16_t status, uint8_t first, uint8_t count){
+    int hi = -1;
+    for (uint8_t i = 0; i < count; ++i){
+      if (status & (1u << (first + i))) hi = i;
+    }
+    if (hi < 0) return 0;
+    if (hi + 1 < count) ++hi;
+    return (uint8_t)(first + hi + 1);
+  }
+
+  // 추적 읽기 범위: 두 축 창 중 뒤쪽 끝까지(0x00부터 연속이어야 한 번의 auto-increment 버스트로 읽힘)
+  uint8_t trackSpanEnd(uint16_t status){
+    const uint8_t y = windowEnd(status, Const::TOUCH_Y_FIRST, Const::TOUCH_Y_COUNT);
+    const uint8_t x = windowEnd(status, Const::TOUCH_X_FIRST, Const::TOUCH_X_COUNT);
+    return (x > y) ? x : y;
+  }
+
+  // 추적 읽기: 0x00부터 직전 상태의 창 끝까지 한 번에(상태 + 필터값, 보통 43 → ≈20바이트).
+  // 새 상태의 창이 그 범위를 넘으면(손가락이 창 밖으로 이동) 전체 버스트로 대신함.
+  // 베이스라인은 직전 전체 버스트 값을 유지하고, 범위 밖 전극은 신호 0(filt = base×4)으로 둠
+  bool touchTrack(TouchSample& s, uint64_t t_us){
+    const uint8_t end = trackSpanEnd(s.status);
+    const uint8_t n   = end ? (uint8_t)(MPR_REG_FILT + 2 * end) : 2;
+    uint8_t b[MPR_REG_FILT + 2 * Const::TOUCH_ELECTRODES];
+    if (!mprRead(MPR_REG_TOUCH, b, n)) return false;
+    const uint16_t status = (uint16_t)((b[0] | (b[1] << 8)) & 0x0FFF);
+    if (trackSpanEnd(status) > end) return touchBurst(s, t_us);
+    s.status = status;
+    for (uint8_t e = 0; e < Const::TOUCH_ELECTRODES; ++e){
+      s.filt[e] = (e < end)
+        ? (uint16_t)((b[MPR_REG_FILT + 2 * e] | (b[MPR_REG_FILT + 2 * e + 1] << 8)) & 0x03FF)
+        : (uint16_t)(s.base[e] * 4u);
+    }
+    touchFinish(s, t_us);
+    return true;
+  }
+
+  // 추적 주기: 터치 tick 주기의 정수배 중 TOUCH_TRACK_MIN_US 이상인 최소값
+  // (tick보다 촘촘히 읽어 봐야 소비되지 않는 샘플 → 버스만 점유)
+  uint32_t trackPeriodUs(uint32_t tick_us){
+    if (!tick_us) return TOUCH_TRACK_MIN_US;
+    return tick_us * ((TOUCH_TRACK_MIN_US + tick_us - 1) / tick_us);
+  }
+
+  inline TickType_t trackTicks(){
+    const uint32_t ms = (s_touchTrackUs.load(std::memory_order_relaxed) + 500u) / 1000u;
+    return pdMS_TO_TICKS(ms ? ms : 1);
+  }
+
+  void publishTouch(const TouchSample& s){
+    s_touchSeq.fetch_add(1, std::memory_order_acq_rel);      // → 홀수
+    s_touchPub = s;
+    s_touchSeq.fetch_add(1, std::memory_order_release);      // → 짝수
+  }
+
+  void latestTouch(TouchSample& out){
+    for (;;) {
+      const uint32_t s1 = s_touchSeq.load(std::memory_order_acquire);
+      if (s1 & 1u) continue;
+      out = s_touchPub;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s_touchSeq.load(std::memory_order_relaxed) == s1) return;
+    }
+  }
+
+  void taskTouch(void*){
+    TouchSample s;   // 태스크 전용 작업본 — 게시는 publishTouch로만
+    uint8_t tracked = 0;
+    for(;;){
+#if CFG_TOUCH_IRQ
+      // 닿아 있으면 추적 주기마다 깨어 추가 읽기, 떨어져 있으면 IRQ까지 대기(버스 트래픽 0)
+      const bool irq = ulTaskNotifyTake(pdTRUE, s.status ? trackTicks() : portMAX_DELAY) != 0;
+      uint64_t t = (uint64_t)esp_timer_get_time();
+      bool full = false;
+      // 에지를 놓쳤어도 라인이 LOW로 남아 있으면 읽어서 해제
+      if (irq || s_touchIrq || digitalRead(Pin::TOUCH_IRQ) == LOW) {
+        if (s_touchIrq) t = s_touchIrqUs;
+        s_touchIrq = false;
+        full = true;   // 상태 변화 → 베이스라인까지 갱신
+      } else if (!s.status) {
+        continue;
+      }
+#else
+      // IRQ 없이 추적 주기마다 폴링 — 떨어져 있으면 창이 비어 상태 2바이트만 읽힘
+      vTaskDelay(trackTicks());
+      const uint64_t t = (uint64_t)esp_timer_get_time();
+      const bool full = (s.seq == 0);   // 첫 읽기는 베이스라인 확보용 전체 버스트
+#endif
+      if (full || ++tracked >= TOUCH_FULL_EVERY) tracked = 0;
+      const bool ok = (full || !tracked) ? touchBurst(s, t) : touchTrack(s, t);
+      if (ok) publishTouch(s);
+    }
+  }
+
+  // ---- ADC Continuous(DMA) ----
+  // 채널 순서 = AdcFrame 필드 순서
+  enum : uint8_t { CH_LX = 0, CH_LY, CH_RX, CH_RY, CH_SLIDER, CH_COUNT };
+  const int kAdcPins[CH_COUNT] = { Pin::JS_L_X, Pin::JS_L_Y, Pin::JS_R_X, Pin::JS_R_Y, Pin::SLIDER };
+
+  constexpr uint8_t  ADC_OS_MAX        = 16;
+  constexpr uint32_t ADC_FRAME_US      = 1000;  // DMA 프레임 목표 주기(≈1ms)
+  constexpr uint32_t ADC_TASK_STACK    = 3072;
+  constexpr UBaseType_t ADC_TASK_PRIO  = 3;
+  constexpr BaseType_t  ADC_TASK_CORE  = 0;     // 입력 태스크(코어1)와 분리
+
+  struct AdcChan {
+    adc_unit_t    unit;
+    adc_channel_t ch;
+    bool          dma;      // DMA 패턴에 포함됐는지(미지원 유닛이면 OneShot 폴백)
+  };
+
+  // 드라이버 수명(핸들 생성/해제)과 s_adcCh는 ADC 태스크만 다룸.
+  // 다른 태스크는 아래 게시 값(s_adcMode, s_adcDmaMask)과 seqlock 프레임만 읽음
+  //  - 정지: 게시 값을 먼저 내리고(release) 그 뒤 해제 → 읽는 쪽은 핸들을 쓰지 않으므로 UAF 없음
+  //  - 시작: 드라이버 시작 성공 후 마스크 → 모드 순으로 게시
+  std::atomic<AdcMode> s_adcMode{ AdcMode::OneShot };
+  std::atomic<uint8_t> s_adcDmaMask{ 0 };   // bit c = 채널 c가 DMA 프레임에 포함
+  AdcReduce      s_adcReduce = AdcReduce::TrimmedMean;
+  uint8_t        s_adcOs     = 8;
+  AdcChan        s_adcCh[CH_COUNT] = {};
+  adc_continuous_handle_t s_adcHandle = nullptr;
+  TaskHandle_t   s_adcTask   = nullptr;
+  uint32_t       s_adcFrameBytes = 0;
+
+  // ADC 태스크 알림 비트
+  constexpr uint32_t ADC_NOTIFY_DATA = 1u << 0;   // 변환 프레임 완료(ISR)
+  constexpr uint32_t ADC_NOTIFY_REQ  = 1u << 1;   // 모드 변경 요청(adcSetMode)
+
+  // 모드 변경 요청: adcSetMode가 채워 알리고, ADC 태스크가 처리 후 s_adcReqDone을 give
+  struct AdcReq {
+    AdcMode   mode;
+    uint8_t   os;
+    AdcReduce reduce;
+    bool      ok;
+  };
+  AdcReq            s_adcReq{};
+  SemaphoreHandle_t s_adcReqDone = nullptr;
+  SemaphoreHandle_t s_adcReqLock = nullptr;     // 요청자 직렬화
+
+  // seqlock: 홀수 = 쓰는 중. 단일 writer(ADC 태스크), 다중 reader
+  std::atomic<uint32_t> s_adcSeq{0};
+  AdcFrame       s_adcFrame{};
+  uint32_t       s_adcFrameNo = 0;
+
+  bool IRAM_ATTR onAdcConvDone(adc_continuous_handle_t, const adc_continuous_evt_data_t*, void*){
+    BaseType_t woken = pdFALSE;
+    if (s_adcTask) xTaskNotifyFromISR(s_adcTask, ADC_NOTIFY_DATA, eSetBits, &woken);
+    return woken == pdTRUE;
+  }
+
+  // 작은 배열 삽입 정렬(채널당 ≤ 2×ADC_OS_MAX)
+  void sortSmall(uint16_t* a, uint8_t n){
+    for (uint8_t i = 1; i < n; ++i){
+      const uint16_t v = a[i];
+      int8_t j = (int8_t)(i - 1);
+      while (j >= 0 && a[j] > v){ a[j+1] = a[j]; --j; }
+      a[j+1] = v;
+    }
+  }
+
+  uint16_t reduceSamples(uint16_t* a, uint8_t n, AdcReduce mode){
+    if (n == 0) return 0;
+    if (mode == AdcReduce::Average){
+      uint32_t sum = 0; for (uint8_t i = 0; i < n; ++i) sum += a[i];
+      return (uint16_t)((sum + n / 2) / n);
+    }
+    sortSmall(a, n);
+    if (mode == AdcReduce::Median){
+      return (n & 1) ? a[n/2] : (uint16_t)((a[n/2 - 1] + a[n/2] + 1) / 2);
+    }
+    // TrimmedMean: 양끝 25%씩 제외
+    const uint8_t cut = n / 4;
+    uint32_t sum = 0;
+    for (uint8_t i = cut; i < n - cut; ++i) sum += a[i];
+    const uint8_t m = n - 2 * cut;
+    return (uint16_t)((sum + m / 2) / m);
+  }
+
+  void publishFrame(const uint16_t v[CH_COUNT], uint8_t samples){
+    s_adcSeq.fetch_add(1, std::memory_order_acq_rel);      // → 홀수
+    s_adcFrame.lx = v[CH_LX]; s_adcFrame.ly = v[CH_LY];
+    s_adcFrame.rx = v[CH_RX]; s_adcFrame.ry = v[CH_RY];
+    s_adcFrame.slider  = v[CH_SLIDER];
+    s_adcFrame.samples = samples;
+    s_adcFrame.seq     = ++s_adcFrameNo;
+    s_adcFrame.t_us    = (uint64_t)esp_timer_get_time();
+    s_adcSeq.fetch_add(1, std::memory_order_release);      // → 짝수
+  }
+
+  void adcServeRequest();
+
+  void taskAdc(void*){
+    static uint8_t  buf[SOC_ADC_DIGI_RESULT_BYTES * CH_COUNT * ADC_OS_MAX * 2];
+    static uint16_t bins[CH_COUNT][ADC_OS_MAX * 2];
+    for(;;){
+      uint32_t bits = 0;
+      xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY);
+      // 시작/정지는 읽기 루프 밖, 이 태스크 안에서만 → 읽는 도중 핸들이 해제되지 않음
+      if (bits & ADC_NOTIFY_REQ) adcServeRequest();
+      uint32_t got = 0;
+      // 쌓인 프레임을 모두 비우되, 발행은 프레임 단위
+      while (s_adcHandle &&
+             adc_continuous_read(s_adcHandle, buf, s_adcFrameBytes, &got, 0) == ESP_OK && got){
+        uint8_t n[CH_COUNT] = {0};
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= got; i += SOC_ADC_DIGI_RESULT_BYTES){
+          const adc_digi_output_data_t* p = reinterpret_cast<const adc_digi_output_data_t*>(&buf[i]);
+          const uint8_t unit = p->type2.unit;
+          const uint8_t ch   = p->type2.channel;
+          for (uint8_t c = 0; c < CH_COUNT; ++c){
+            if (s_adcCh[c].dma && s_adcCh[c].unit == (adc_unit_t)unit && s_adcCh[c].ch == (adc_channel_t)ch){
+              if (n[c] < ADC_OS_MAX * 2) bins[c][n[c]++] = (uint16_t)p->type2.data;
+              break;
+            }
+          }
+        }
+        uint16_t v[CH_COUNT];
+        uint8_t minN = 0xFF;
+        bool any = false;
+        for (uint8_t c = 0; c < CH_COUNT; ++c){
+          if (!s_adcCh[c].dma){ v[c] = 0; continue; }
+          if (!n[c]){
+            // 이 프레임에 샘플 없음 → 직전 값 유지
+            const uint16_t prev[CH_COUNT] = { s_adcFrame.lx, s_adcFrame.ly, s_adcFrame.rx, s_adcFrame.ry, s_adcFrame.slider };
+            v[c] = prev[c];
+            continue;
+          }
+          v[c] = reduceSamples(bins[c], n[c], s_adcReduce);
+          if (n[c] < minN) minN = n[c];
+          any = true;
+        }
+        if (any) publishFrame(v, minN);
+      }
+    }
+  }
+
+  // 이하 ADC 태스크 컨텍스트 전용
+  void adcStopContinuous(){
+    // 읽는 쪽을 먼저 OneShot 경로로 돌린 뒤 해제
+    s_adcMode.store(AdcMode::OneShot, std::memory_order_release);
+    s_adcDmaMask.store(0, std::memory_order_release);
+    if (!s_adcHandle) return;
+    adc_continuous_stop(s_adcHandle);
+    adc_continuous_deinit(s_adcHandle);
+    s_adcHandle = nullptr;
+    for (uint8_t c = 0; c < CH_COUNT; ++c) s_adcCh[c].dma = false;
+  }
+
+  bool adcStartContinuous(uint8_t os, AdcReduce reduce){
+    adcStopContinuous();
+
+    adc_digi_pattern_config_t pattern[CH_COUNT] = {};
+    uint8_t np = 0;
+    bool useUnit[2] = { false, false };
+    for (uint8_t c = 0; c < CH_COUNT; ++c){
+      adc_unit_t unit; adc_channel_t ch;
+      s_adcCh[c].dma = false;
+      if (adc_continuous_io_to_channel(kAdcPins[c], &unit, &ch) != ESP_OK) continue;
+      s_adcCh[c].unit = unit;
+      s_adcCh[c].ch   = ch;
+      if (!SOC_ADC_DIG_SUPPORTED_UNIT(unit)) continue;   // DMA 미지원 유닛 → OneShot 폴백
+      // Arduino OneShot 드라이버가 잡고 있는 핀을 해제(analogContinuous와 동일한 절차)
+      perimanClearPinBus(kAdcPins[c]);
+      pattern[np].atten     = ADC_ATTEN_DB_12;
+      pattern[np].channel   = ch;
+      pattern[np].unit      = unit;
+      pattern[np].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+      ++np;
+      s_adcCh[c].dma = true;
+      useUnit[unit == ADC_UNIT_2 ? 1 : 0] = true;
+    }
+    if (!np) return false;
+
+    s_adcFrameBytes = SOC_ADC_DIGI_RESULT_BYTES * np * os;
+    adc_continuous_handle_cfg_t hcfg = {};
+    hcfg.max_store_buf_size = s_adcFrameBytes * 4;
+    hcfg.conv_frame_size    = s_adcFrameBytes;
+    if (adc_continuous_new_handle(&hcfg, &s_adcHandle) != ESP_OK){
+      s_adcHandle = nullptr;
+      for (uint8_t c = 0; c < CH_COUNT; ++c) s_adcCh[c].dma = false;
+      return false;
+    }
+
+    // 프레임(채널당 os 샘플)이 ≈ADC_FRAME_US마다 완성되도록 변환 속도 결정
+    uint32_t freq = (uint32_t)np * os * (1000000u / ADC_FRAME_US);
+    if (freq < SOC_ADC_SAMPLE_FREQ_THRES_LOW)  freq = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+    if (freq > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) freq = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+
+    adc_continuous_config_t dcfg = {};
+    dcfg.pattern_num    = np;
+    dcfg.adc_pattern    = pattern;
+    dcfg.sample_freq_hz = freq;
+    dcfg.conv_mode      = (useUnit[0] && useUnit[1]) ? ADC_CONV_BOTH_UNIT :
+                          useUnit[1] ? ADC_CONV_SINGLE_UNIT_2 : ADC_CONV_SINGLE_UNIT_1;
+    dcfg.format         = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+    adc_continuous_evt_cbs_t cbs = {};
+    cbs.on_conv_done = onAdcConvDone;
+
+    s_adcOs = os;
+    s_adcReduce = reduce;
+    if (adc_continuous_config(s_adcHandle, &dcfg) != ESP_OK ||
+        adc_continuous_register_event_callbacks(s_adcHandle, &cbs, nullptr) != ESP_OK ||
+        adc_continuous_start(s_adcHandle) != ESP_OK){
+      adcStopContinuous();
+      return false;
+    }
+    uint8_t mask = 0;
+    for (uint8_t c = 0; c < CH_COUNT; ++c) if (s_adcCh[c].dma) mask |= (uint8_t)(1u << c);
+    s_adcDmaMask.store(mask, std::memory_order_release);
+    s_adcMode.store(AdcMode::Continuous, std::memory_order_release);
+    return true;
+  }
+
+  void adcServeRequest(){
+    AdcReq& r = s_adcReq;
+    if (r.mode == AdcMode::OneShot){
+      adcStopContinuous();
+      HAL::configureAdc();   // OneShot 어텐 재설정(핀은 analogRead 시 자동 재부착)
+      r.ok = true;
+    } else if (s_adcHandle && r.os == s_adcOs){
+      // 같은 구성으로 이미 동작 중이면 축약 방식만 갱신
+      s_adcReduce = r.reduce;
+      r.ok = true;
+    } else {
+      // 재시작 중에는 adcStopContinuous가 내린 OneShot 경로로 응답
+      r.ok = adcStartContinuous(r.os, r.reduce);
+      if (!r.ok) HAL::configureAdc();
+    }
+    xSemaphoreGive(s_adcReqDone);
+  }
 }
 
 // ========== 초기화 ==========
@@ -35,10 +470,17 @@ void HAL::init() {
   cfgInputPullup(Pin::JS_R_SW);
 
   // I2C (공유)
-  Wire.begin(Pin::SDA, Pin::SCL, 100000);
+  Wire.begin(Pin::SDA, Pin::SCL, I2C_HZ);
 
   // CapaTouch 시작 (실패해도 계속 진행; 상위에서 graceful degrade)
   CapaTouch.begin();
+  xTaskCreatePinnedToCore(taskTouch, "Touch", TOUCH_TASK_STACK, nullptr, TOUCH_TASK_PRIO, &s_touchTask, TOUCH_TASK_CORE);
+#if CFG_TOUCH_IRQ
+  pinMode(Pin::TOUCH_IRQ, INPUT_PULLUP);
+  attachInterrupt(Pin::TOUCH_IRQ, onTouchIrq, FALLING);
+  // 부팅 전에 이미 LOW였을 수 있으므로 한 번 깨워 확인
+  if (s_touchTask) xTaskNotifyGive(s_touchTask);
+#endif
 
   // ADC
   configureAdc();
@@ -73,33 +515,114 @@ bool HAL::readTouchDigital() {
   return Const::TOUCH_ACTIVE_HIGH ? (v == HIGH) : (v == LOW);
 }
 
+uint32_t HAL::readButtonMask() {
+  // 두 레지스터를 연달아 읽어 모든 버튼을 같은 시점으로 샘플
+  const uint32_t in0 = REG_READ(GPIO_IN_REG);
+  const uint32_t in1 = REG_READ(GPIO_IN1_REG);
+  uint32_t mask = 0;
+  for (const BtnMap& m : kBtnMap) {
+    const bool high = (m.gpio < 32) ? ((in0 >> m.gpio) & 1u) : ((in1 >> (m.gpio - 32)) & 1u);
+    if (high == m.activeHigh) mask |= buttonBit(m.btn);
+  }
+  return mask;
+}
+
 // ========== 아날로그 ==========
 int HAL::readSliderRaw() {
-  return analogRead(Pin::SLIDER);
+  return readAdcPin(Pin::SLIDER);
 }
 
 void HAL::readSticksRaw(SticksRaw& s) {
+  AdcFrame f;
+  if (s_adcMode.load(std::memory_order_acquire) == AdcMode::Continuous && adcLatest(f)) {
+    // DMA 대상이 아닌 채널(유닛 미지원)만 OneShot 폴백
+    const uint8_t m = s_adcDmaMask.load(std::memory_order_acquire);
+    s.lx = (m & (1u << CH_LX)) ? f.lx : analogRead(Pin::JS_L_X);
+    s.ly = (m & (1u << CH_LY)) ? f.ly : analogRead(Pin::JS_L_Y);
+    s.rx = (m & (1u << CH_RX)) ? f.rx : analogRead(Pin::JS_R_X);
+    s.ry = (m & (1u << CH_RY)) ? f.ry : analogRead(Pin::JS_R_Y);
+    return;
+  }
   s.lx = analogRead(Pin::JS_L_X);
   s.ly = analogRead(Pin::JS_L_Y);
   s.rx = analogRead(Pin::JS_R_X);
   s.ry = analogRead(Pin::JS_R_Y);
 }
 
-// ========== CapaTouch ==========
-bool HAL::touchGetCoord(TouchPt& out) {
-  // CapaTouch.getX()/getY()는 유효 좌표가 아닐 때 보통 0 또는 범위 밖 값을 리턴
-  int x = CapaTouch.getX();
-  int y = CapaTouch.getY();
-
-  if (x >= Const::CX_MIN && x <= Const::CX_MAX &&
-      y >= Const::CY_MIN && y <= Const::CY_MAX) {
-    // 기존 구현처럼 X축 반전(터치패드 좌우 방향 맞춤)
-    x = (Const::CX_MAX + 1) - x;
-    out.x = x;
-    out.y = y;
+int HAL::readAdcPin(int pin) {
+  AdcFrame f;
+  if (s_adcMode.load(std::memory_order_acquire) == AdcMode::Continuous && adcLatest(f)) {
+    const uint16_t v[CH_COUNT] = { f.lx, f.ly, f.rx, f.ry, f.slider };
+    const uint8_t  m = s_adcDmaMask.load(std::memory_order_acquire);
+    for (uint8_t c = 0; c < CH_COUNT; ++c) {
+      if (kAdcPins[c] == pin && (m & (1u << c))) return v[c];
+    }
+  }
+  return analogRead(pin);
+}
+
+// ========== ADC Continuous(DMA) ==========
+bool HAL::adcSetMode(AdcMode mode, uint8_t oversample, AdcReduce reduce) {
+  if (oversample < 1) oversample = 1;
+  if (oversample > ADC_OS_MAX) oversample = ADC_OS_MAX;
+
+  // DMA를 한 번도 시작하지 않았다면 태스크 없이 OneShot 설정만
+  if (!s_adcTask && mode == AdcMode::OneShot) {
+    configureAdc();
     return true;
   }
-  return false;
+
+  // 드라이버 시작/정지는 ADC 태스크가 읽기 루프 밖에서 수행 → 요청 후 완료 대기
+  if (!s_adcTask) {
+    s_adcReqDone = xSemaphoreCreateBinary();
+    s_adcReqLock = xSemaphoreCreateMutex();
+    xTaskCreatePinnedToCore(taskAdc, "ADCDMA", ADC_TASK_STACK, nullptr, ADC_TASK_PRIO, &s_adcTask, ADC_TASK_CORE);
+    if (!s_adcTask) { configureAdc(); return false; }
+  }
+
+  xSemaphoreTake(s_adcReqLock, portMAX_DELAY);
+  s_adcReq.mode   = mode;
+  s_adcReq.os     = oversample;
+  s_adcReq.reduce = reduce;
+  s_adcReq.ok     = false;
+  xTaskNotify(s_adcTask, ADC_NOTIFY_REQ, eSetBits);
+  xSemaphoreTake(s_adcReqDone, portMAX_DELAY);
+  const bool ok = s_adcReq.ok;
+  xSemaphoreGive(s_adcReqLock);
+  return ok;
+}
+
+AdcMode HAL::adcMode() { return s_adcMode.load(std::memory_order_acquire); }
+
+bool HAL::adcLatest(AdcFrame& out) {
+  for (;;) {
+    const uint32_t s1 = s_adcSeq.load(std::memory_order_acquire);
+    if (s1 & 1u) continue;                 // 쓰는 중 — 수 µs 이내 끝남
+    out = s_adcFrame;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32_t s2 = s_adcSeq.load(std::memory_order_relaxed);
+    if (s1 == s2) return out.seq != 0;
+  }
+}
+
+// ========== CapaTouch ==========
+bool HAL::touchGetCoord(TouchPt& out) {
+  TouchSample s;
+  latestTouch(s);
+  if (!s.seq || !s.valid) return false;
+  out = s.pt;
+  return true;
+}
+
+void HAL::touchSetTickPeriod(uint32_t tick_us) {
+  s_touchTrackUs.store(trackPeriodUs(tick_us), std::memory_order_relaxed);
+}
+
+bool HAL::touchPoll(TouchSample& out, uint64_t now_us) {
+  (void)now_us;   // 타임스탬프는 수집 태스크가 IRQ/읽은 시각으로 기록
+  const uint32_t prev = out.seq;
+  latestTouch(out);
+  return out.seq != prev;
 }
 
 // ========== I2C ==========
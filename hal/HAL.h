@@ -28,6 +28,9 @@ namespace HAL::Pin {
   // Touch (디지털 탭 감지)
   inline constexpr int TOUCH_DIGITAL = 2; // ACTIVE_HIGH
 
+  // MPR121 IRQ (오픈 드레인, ACTIVE_LOW — 터치 상태 변화 시 LOW, 상태 레지스터 읽으면 해제)
+  inline constexpr int TOUCH_IRQ = 8;
+
   // Slider (ADC)
   inline constexpr int SLIDER = 15;
 
@@ -58,6 +61,14 @@ namespace HAL::Const {
   // CapaTouch 좌표 유효 범위 (MPR121)
   inline constexpr int CX_MIN = 1, CX_MAX = 9;
   inline constexpr int CY_MIN = 1, CY_MAX = 13;
+
+  // MPR121 전극 배치: Y = E0..E6(7), X = E7..E11(5)
+  //  - 좌표 = 닿은 전극 최소/최대 인덱스 합 + 1 → 전극 위 홀수, 두 전극 사이 짝수(X 1..9, Y 1..13)
+  inline constexpr uint8_t MPR121_ADDR    = 0x5B;
+  inline constexpr uint8_t DRV2605_ADDR   = 0x5A;
+  inline constexpr uint8_t TOUCH_ELECTRODES = 12;
+  inline constexpr uint8_t TOUCH_Y_FIRST  = 0, TOUCH_Y_COUNT = 7;
+  inline constexpr uint8_t TOUCH_X_FIRST  = 7, TOUCH_X_COUNT = 5;
 }
 
 // ========= 버튼/입력 열거 =========
@@ -66,9 +77,73 @@ enum class Button : uint8_t {
   A, B, X, Y, L3, R3, TouchDigital
 };
 
+// 버튼 비트마스크: bit = Button 열거 순서
+inline constexpr uint32_t buttonBit(Button b){ return 1u << static_cast<uint8_t>(b); }
+
+// 입력 스냅샷(tick당 1회 생성, 모든 파이프라인이 같은 샘플을 공유)
+struct InputFrame {
+  uint32_t level    = 0;   // 현재 눌림(1 = pressed)
+  uint32_t pressed  = 0;   // 직전 프레임 대비 새로 눌림
+  uint32_t released = 0;   // 직전 프레임 대비 새로 떼짐
+  uint32_t t_ms     = 0;
+  uint64_t t_us     = 0;   // 프레임 타임스탬프(esp_timer, 필터 dt 계산용)
+
+  bool down(Button b) const { return (level    & buttonBit(b)) != 0; }
+  bool rose(Button b) const { return (pressed  & buttonBit(b)) != 0; }
+  bool fell(Button b) const { return (released & buttonBit(b)) != 0; }
+  bool all(uint32_t mask) const { return (level & mask) == mask; }
+
+  // 새 레벨로 갱신 + 에지 계산
+  void update(uint32_t mask, uint64_t now_us){
+    const uint32_t chg = mask ^ level;
+    pressed  = chg & mask;
+    released = chg & level;
+    level    = mask;
+    t_us     = now_us;
+    t_ms     = (uint32_t)(now_us / 1000u);
+  }
+
+  // 분주 실행 파이프라인용: 건너뛴 프레임의 에지를 누적
+  void merge(const InputFrame& f){
+    pressed  |= f.pressed;
+    released |= f.released;
+    level     = f.level;
+    t_ms      = f.t_ms;
+    t_us      = f.t_us;
+  }
+  void clearEdges(){ pressed = 0; released = 0; }
+};
+
+// MPR121 샘플(레지스터 0x00..0x2A 버스트 1회)
+struct TouchSample {
+  uint64_t t_us     = 0;   // IRQ 시각(IRQ 모드) 또는 읽은 시각(esp_timer)
+  uint32_t seq      = 0;   // 새 샘플마다 증가(0 = 아직 없음)
+  uint16_t status   = 0;   // 전극 터치 비트(E0..E11)
+  uint16_t filt[Const::TOUCH_ELECTRODES]  = {0};   // 필터 데이터(10비트)
+  uint8_t  base[Const::TOUCH_ELECTRODES]  = {0};   // 베이스라인(상위 8비트, ×4 = 필터 단위)
+  bool     valid    = false;                       // X/Y 양 축에 닿은 전극이 있음
+  TouchPt  pt       = {0, 0};                      // 격자 좌표(X 반전 적용, Const::CX/CY 범위)
+};
+
 struct SticksRaw {
   int lx, ly, rx, ry; // 0..4095 (12-bit)
 };
+
+// ADC 동작 모드
+//  - OneShot   : 호출 시마다 analogRead (기존 방식, 블로킹)
+//  - Continuous: adc_continuous(DMA)가 링버퍼로 상시 샘플링 → 최신 오버샘플 프레임 제공
+enum class AdcMode : uint8_t { OneShot = 0, Continuous = 1 };
+
+// 오버샘플 축약 방식(채널별 샘플 묶음 → 1개 값)
+enum class AdcReduce : uint8_t { Average = 0, Median = 1, TrimmedMean = 2 };
+
+// 최신 오버샘플 프레임(스틱 4축 + 슬라이더)
+struct AdcFrame {
+  uint16_t lx, ly, rx, ry, slider; // 0..4095
+  uint8_t  samples;                // 채널당 축약에 사용된 샘플 수(최소값)
+  uint32_t seq;                    // 프레임 번호(새 프레임 판별용)
+  uint64_t t_us;                   // 발행 시각(esp_timer)
+};
 } // namespace HAL
 
 // ========= API =========
@@ -77,7 +152,7 @@ namespace HAL {
 // 초기화 (핀모드, I2C, ADC 해상도/어텐 설정, 터치칩 시작 등)
 void init();
 
-// 주기 호출 필요 없음. (타이머/IRQ 사용 안 함) — 필요 시 tick() 추가 가능
+// 주기 호출 필요 없음. (ADC Continuous 모드는 내부 태스크가 DMA 프레임 처리)
 // void tick(uint32_t now_ms);
 
 // LED
@@ -90,13 +165,38 @@ void ledAllOff();
 bool pressed(Button b);          // 풀업 기준: LOW = pressed
 bool readTouchDigital();         // 단순 디지털 탭 입력
 
-// 아날로그 입력
+// 전체 버튼을 GPIO IN/IN1 레지스터 2회 읽기로 샘플(bit = buttonBit, 1 = pressed)
+uint32_t readButtonMask();
+
+// 아날로그 입력 (Continuous 모드면 최신 DMA 프레임에서 즉시 반환 — 블로킹 없음)
 int  readSliderRaw();            // 0..4095
 void readSticksRaw(SticksRaw& s);// 각 축 0..4095
 
-// CapaTouch (MPR121) 좌표 — 좌표가 유효하면 true
+// ADC 모드 전환(런타임 가능). oversample: 채널당 1..16
+// 드라이버 시작/정지는 ADC 태스크가 수행하고, 호출자는 처리 완료까지 대기(ISR/입력 태스크에서 호출 금지)
+// Continuous 시작 실패(드라이버/유닛 미지원) 시 OneShot 유지하고 false
+bool adcSetMode(AdcMode mode, uint8_t oversample = 8, AdcReduce reduce = AdcReduce::TrimmedMean);
+AdcMode adcMode();
+
+// 최신 프레임(락프리, seqlock). Continuous 모드에서 프레임이 아직 없으면 false
+bool adcLatest(AdcFrame& out);
+
+// 단일 핀 읽기: Continuous 모드이고 DMA 대상 핀이면 최신 프레임 값, 아니면 analogRead
+int  readAdcPin(int pin);
+
+// CapaTouch (MPR121) 좌표 — 최신 게시 샘플의 좌표가 유효하면 true (팩토리 테스트 등, I2C 접근 없음)
 bool touchGetCoord(TouchPt& out);
 
+// 터치 수집: 전용 태스크(코어0)가 I2C 버스트를 수행하고 seqlock으로 게시 — 입력 tick은 복사만 함
+//  - CFG_TOUCH_IRQ=1: IRQ 에지(또는 IRQ 라인 LOW 유지) 때 전체 버스트, 닿아 있는 동안은 추적 주기마다
+//                     상태 + 닿은 전극 ±1 창의 필터값만 추가로 읽음(서브셀 무게중심 추적용)
+//                     — 손가락이 없으면 버스 트래픽 0
+//  - CFG_TOUCH_IRQ=0: 추적 주기마다 폴링(떨어져 있으면 상태 2바이트만, 읽은 시각을 타임스탬프로 사용)
+//  - 추적 주기 = touchSetTickPeriod로 받은 터치 tick 주기의 정수배 중 5ms 이상인 최소값
+// touchPoll: out.seq 이후 새 샘플이 게시됐으면 true, out은 항상 최신 샘플(now_us는 호환용, 미사용)
+bool touchPoll(TouchSample& out, uint64_t now_us);
+void touchSetTickPeriod(uint32_t tick_us);   // 터치 파이프라인 tick 주기(입력 주기 × 분주비)
+
 // I2C 접근자 (공유 Wire)
 TwoWire& i2c();
 
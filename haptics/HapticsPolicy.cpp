@@ -113,8 +113,14 @@ bool fuseCheckAndAdjust(ErmDir dir, uint32_t nowMs, uint32_t &ms, uint16_t &duty
 }
 
 void fuseAccumulate(ErmDir dir, uint32_t ms, uint16_t duty) {
-  float dn = static_cast<float>(duty) / 1023.0f;
-  float e  = (dn * dn) * (static_cast<float>(ms) / 1000.0f); // 대략적인 에너지
+  fuseAccumulate(dir, ms, duty, duty);
+}
+
+void fuseAccumulate(ErmDir dir, uint32_t ms, uint16_t dutyFrom, uint16_t dutyTo) {
+  // ∫(듀티²)dt, 듀티가 a → b로 선형: T·(a² + ab + b²)/3 (사각 펄스면 T·a²)
+  const float a = static_cast<float>(dutyFrom) / 1023.0f;
+  const float b = static_cast<float>(dutyTo)   / 1023.0f;
+  float e  = ((a * a + a * b + b * b) / 3.0f) * (static_cast<float>(ms) / 1000.0f);
   switch (dir) {
     case ErmDir::LEFT:  s_fuse.loadL += e; break;
     case ErmDir::RIGHT: s_fuse.loadR += e; break;
@@ -30,6 +30,8 @@ uint16_t clampDuty(uint16_t d);      // 0..1023
 bool fuseCheckAndAdjust(ErmDir dir, uint32_t nowMs, uint32_t &ms, uint16_t &duty);
 // 실행 뒤 누적(부하 적산)
 void fuseAccumulate(ErmDir dir, uint32_t ms, uint16_t duty);
+// 선형 램프 구간 적산: duty가 ms 동안 dutyFrom → dutyTo (에너지 ∝ T·(a²+ab+b²)/3)
+void fuseAccumulate(ErmDir dir, uint32_t ms, uint16_t dutyFrom, uint16_t dutyTo);
 // 상태 조회(로그/CLI)
 void fuseGetLoads(float &loadL, float &loadR, uint32_t nowMs, long &cooldownLeftMs);
 
@@ -1,5 +1,9 @@
 #include "HapticsRuntime.h"
 #include <Wire.h>
+#include "esp_timer.h"
+#include "driver/ledc.h"
+#include <atomic>
+#include <string.h>
 
 namespace {
 
@@ -17,107 +21,498 @@ static SemaphoreHandle_t s_i2cMutex = nullptr;
 static Adafruit_DRV2605 s_drv;
 static bool s_lraReady = false;
 
-// ERM 구동 상태(간단 플래그)
-static volatile bool s_ermRunningL = false;
-static volatile bool s_ermRunningR = false;
-
 // 하프틱 명령
-enum class HCmdType : uint8_t { ERM, LRA };
+//  - ERM/LRA/SEQ: 재생 요청(API → 큐)
+//  - RTP: 스트리밍 시작/갱신(주기·반복)
+//  - STOP: 채널 정지
+// 타이머/페이드 완료는 큐가 아니라 태스크 알림 비트로(아래 EV_*) — 큐가 차 있어도 유실되지 않음
+enum class HCmdType : uint8_t { ERM, LRA, SEQ, RTP, STOP };
 
 struct HCmdERM {
   ErmDir   dir;
   uint16_t duty;
   uint32_t ms;
+  uint16_t attackMs, decayMs, releaseMs;   // ErmEnvelope(공용체라 기본값 없는 필드로 전달)
+  uint8_t  sustainPct;
 };
 struct HCmdLRA {
   uint8_t  effect;
   uint32_t ms;
 };
+struct HCmdSEQ {
+  uint8_t  slot[HapticsRuntime::LRA_SLOTS];
+};
+struct HCmdRTP {
+  uint16_t rateHz;
+  bool     loop;
+};
 struct HCmd {
   HCmdType type;
-  union { HCmdERM erm; HCmdLRA lra; } u;
+  uint8_t  prio;
+  uint8_t  ch;      // STOP 대상 채널
+  union { HCmdERM erm; HCmdLRA lra; HCmdSEQ seq; HCmdRTP rtp; } u;
 };
 
 // 큐/태스크 핸들
 static QueueHandle_t  s_qHaptics  = nullptr;
 static TaskHandle_t   s_taskHapt  = nullptr;
 
+// 태스크 알림 비트: 채널별 이벤트는 같은 비트로 합쳐짐(재판정은 남은 시간 기준이라 중복 불필요)
+constexpr uint32_t EV_TICK0 = 1u << 0;    // + ch: 채널 타이머 만료(esp_timer)
+constexpr uint32_t EV_FADE0 = 1u << 4;    // + ch: ERM 하드웨어 페이드 완료(LEDC ISR)
+constexpr uint32_t EV_RTP   = 1u << 8;    // RTP 샘플 주기(esp_timer) — 밀린 tick은 1회로 합쳐짐
+constexpr uint32_t EV_CMD   = 1u << 9;    // 큐에 명령 있음
+
 // PWM 파라미터(필요 시 HAL로 승격 가능)
 static constexpr int ERM_PWM_FREQ     = 1000; // Hz
 static constexpr int ERM_PWM_RES_BITS = 10;   // 0..1023
+// ERM LEDC 채널 고정(페이드 중단 ledc_fade_stop에 채널 번호 필요). ESP32-S3는 저속 모드만
+static constexpr uint8_t ERM_LEDC_CH[2] = { 0, 1 };
+constexpr uint32_t FADE_SLACK_MS = 3;          // 페이드 완료 ISR 누락 대비 타이머 여유
+
+constexpr uint32_t LRA_RETRIGGER_MS = 300;    // 재트리거 템포
+constexpr uint32_t SEQ_EFFECT_MS    = 100;    // 시퀀스 길이 추정: 효과 슬롯당(라이브러리 클릭/버즈 대부분 이하)
+
+// DRV2605 레지스터
+constexpr uint8_t DRV_REG_WAVESEQ1 = 0x04;    // 0x04..0x0B 슬롯 8개
+constexpr uint8_t DRV_REG_GO       = 0x0C;    // WAVESEQ8 바로 다음 → 같은 버스트로 GO
+constexpr uint8_t DRV_REG_MODE     = 0x01;
+constexpr uint8_t DRV_REG_RTP      = 0x02;
+constexpr uint8_t DRV_REG_CONTROL3 = 0x1D;
+constexpr uint8_t DRV_MODE_INTTRIG = 0x00;
+constexpr uint8_t DRV_MODE_RTP     = 0x05;
+constexpr uint8_t DRV_C3_RTP_UNSIGNED = 0x08;   // RTP 데이터 0..255(부호 없음)
+constexpr uint8_t  CH_COUNT = (uint8_t)HapticsRuntime::Channel::COUNT;
+constexpr uint8_t  CH_L = (uint8_t)HapticsRuntime::Channel::ERM_LEFT;
+constexpr uint8_t  CH_R = (uint8_t)HapticsRuntime::Channel::ERM_RIGHT;
+constexpr uint8_t  CH_LRA = (uint8_t)HapticsRuntime::Channel::LRA;
+
+// 채널 타임라인(태스크 전용 — active만 다른 태스크에서 조회)
+struct Voice {
+  volatile bool active = false;
+  uint8_t  prio   = 0;
+  uint16_t level  = 0;     // ERM 듀티 / LRA 효과 번호
+  uint32_t t0     = 0;     // 현재 세그먼트 시작(퓨즈 적산 기준)
+  uint32_t endMs  = 0;
+  uint32_t nextMs = 0;     // LRA 다음 재트리거
+  uint8_t  lra    = 0;     // LRA 재생 방식(LRA_*)
+  // ERM 엔벨로프: 현재 세그먼트(from → to, segMs 동안, t0 시작) + 남은 단계
+  uint8_t  stage  = 0;     // ERM_*
+  uint16_t from = 0, to = 0;
+  uint32_t segMs  = 0;
+  uint16_t sustain = 0;
+  uint16_t decayMs = 0, releaseMs = 0;
+  esp_timer_handle_t tmr = nullptr;
+};
+static Voice s_voice[CH_COUNT];
+
+enum : uint8_t { LRA_EFFECT = 0, LRA_SEQ = 1, LRA_RTP = 2 };
+enum : uint8_t { ERM_ATTACK = 0, ERM_DECAY = 1, ERM_SUSTAIN = 2, ERM_RELEASE = 3 };
+
+// RTP 엔벨로프 이중 버퍼 — 상태 바이트 하나로 앞 버퍼 인덱스/교체 대기/작성 중을 원자적으로
+//  - 생산자: BUSY 세팅(이 동안 앞 버퍼 고정) → 뒤 버퍼 작성 → PENDING → BUSY 해제
+//  - 소비자(태스크): PENDING && !BUSY 일 때만 CAS로 FRONT 뒤집기
+constexpr uint8_t ENV_FRONT = 0x01, ENV_PENDING = 0x02, ENV_BUSY = 0x04;
+static uint8_t  s_env[2][HapticsRuntime::RTP_MAX_POINTS];
+static uint16_t s_envLen[2] = {0, 0};
+static std::atomic<uint8_t> s_envState{0};
+
+struct Rtp {
+  uint16_t idx  = 0;
+  uint16_t rateHz = 0;
+  uint8_t  last = 0;
+  bool     loop = false;
+  esp_timer_handle_t tmr = nullptr;
+};
+static Rtp s_rtp;
+
+inline bool before(uint32_t a, uint32_t b){ return (int32_t)(a - b) < 0; }
 
 // 유틸
-inline void ermWrite(bool left, uint16_t duty) {
-  // Arduino-ESP32 v3.x 전용 API: ledcAttach(pin,freq,res), ledcWrite(pin, duty)
-  ledcWrite(left ? Pin::MOTOR_LEFT : Pin::MOTOR_RIGHT, duty);
-  if (left) s_ermRunningL = (duty > 0); else s_ermRunningR = (duty > 0);
+inline uint8_t ermPin(uint8_t ch) { return (ch == CH_L) ? Pin::MOTOR_LEFT : Pin::MOTOR_RIGHT; }
+inline void ermWrite(uint8_t ch, uint16_t duty) {
+  // Arduino-ESP32 v3.x 전용 API: ledcAttachChannel(pin,freq,res,ch), ledcWrite(pin, duty)
+  ledcWrite(ermPin(ch), duty);
+}
+inline void ermFadeStop(uint8_t ch) {
+  ledc_fade_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)ERM_LEDC_CH[ch]);   // 페이드 중이 아니면 무시됨
 }
 inline void ermStopAll() {
   ledcWrite(Pin::MOTOR_LEFT,  0);
   ledcWrite(Pin::MOTOR_RIGHT, 0);
-  s_ermRunningL = s_ermRunningR = false;
+}
+// 슬롯 8개 + GO를 자동 증가 버스트 1회로(주소 1 + 데이터 9바이트)
+void lraBurst(const uint8_t* slot) {
+  TwoWire& w = HAL::i2c();
+  HapticsRuntime::i2cLock();
+  w.beginTransmission(HAL::Const::DRV2605_ADDR);
+  w.write(DRV_REG_WAVESEQ1);
+  w.write(slot, HapticsRuntime::LRA_SLOTS);
+  w.write((uint8_t)1);   // GO
+  w.endTransmission();
+  HapticsRuntime::i2cUnlock();
+}
+void drvWrite(uint8_t reg, uint8_t val) {
+  TwoWire& w = HAL::i2c();
+  HapticsRuntime::i2cLock();
+  w.beginTransmission(HAL::Const::DRV2605_ADDR);
+  w.write(reg);
+  w.write(val);
+  w.endTransmission();
+  HapticsRuntime::i2cUnlock();
+}
+inline void lraGo(uint8_t effect) {
+  const uint8_t slot[HapticsRuntime::LRA_SLOTS] = { effect, 0 };
+  lraBurst(slot);
 }
 
-void taskHaptics(void*) {
-  for(;;) {
-    HCmd cmd;
-    if (xQueueReceive(s_qHaptics, &cmd, portMAX_DELAY) != pdTRUE) continue;
+// 시퀀스 길이 추정(겹침 판정용): 대기 슬롯 합 + 효과 슬롯당 SEQ_EFFECT_MS
+uint32_t seqMs(const uint8_t* slot) {
+  uint32_t ms = 0;
+  for (uint8_t i = 0; i < HapticsRuntime::LRA_SLOTS && slot[i]; ++i)
+    ms += (slot[i] & 0x80) ? (uint32_t)(slot[i] & 0x7F) * 10u : SEQ_EFFECT_MS;
+  return ms;
+}
+
+// esp_timer 콜백(esp_timer 태스크 문맥): 채널 점검 이벤트만 전달
+void onVoiceTimer(void* arg) {
+  xTaskNotify(s_taskHapt, EV_TICK0 << (uintptr_t)arg, eSetBits);
+}
+
+void onRtpTimer(void*) {
+  xTaskNotify(s_taskHapt, EV_RTP, eSetBits);
+}
+
+// LEDC 페이드 완료 ISR: 해당 ERM 채널 점검 이벤트만 전달
+void IRAM_ATTR onFadeDone(void* arg) {
+  BaseType_t woken = pdFALSE;
+  xTaskNotifyFromISR(s_taskHapt, EV_FADE0 << (uintptr_t)arg, eSetBits, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+void armVoice(uint8_t ch, uint32_t inMs) {
+  Voice& v = s_voice[ch];
+  esp_timer_stop(v.tmr);   // 미실행이면 오류 반환 — 무시
+  esp_timer_start_once(v.tmr, (uint64_t)(inMs ? inMs : 1) * 1000u);
+}
+
+// 세그먼트 안의 현재 듀티(램프는 선형 보간)
+uint16_t ermDutyAt(const Voice& v, uint32_t now) {
+  const uint32_t el = now - v.t0;
+  if (!v.segMs || el >= v.segMs) return v.to;
+  return (uint16_t)((int32_t)v.from + ((int32_t)v.to - (int32_t)v.from) * (int32_t)el / (int32_t)v.segMs);
+}
+
+// 지금까지 구동한 ERM 구간(램프 포함)을 퓨즈에 적산하고 남은 구간을 현재 듀티부터 이어감
+void ermCommit(uint8_t ch, uint32_t now) {
+  Voice& v = s_voice[ch];
+  const uint32_t el = now - v.t0;
+  if (!v.active || !el) { v.t0 = now; return; }
+  const uint16_t cur = ermDutyAt(v, now);
+  if (v.from || cur)
+    HapticsPolicy::fuseAccumulate(ch == CH_L ? ErmDir::LEFT : ErmDir::RIGHT, el, v.from, cur);
+  v.from  = cur;
+  v.segMs = (v.segMs > el) ? v.segMs - el : 0;
+  v.t0    = now;
+}
+
+// 세그먼트 시작: 램프는 LEDC 하드웨어 페이드(완료 시 ISR), 유지는 듀티 고정
+void ermSegment(uint8_t ch, uint8_t stage, uint16_t from, uint16_t to, uint32_t ms, uint32_t now) {
+  Voice& v = s_voice[ch];
+  v.stage = stage;
+  v.from  = from;
+  v.to    = to;
+  v.segMs = (from == to) ? 0 : ms;
+  v.t0    = now;
+  ermFadeStop(ch);
+  if (!v.segMs) { ermWrite(ch, to); return; }
+  ledcFadeWithInterruptArg(ermPin(ch), from, to, (int)ms, onFadeDone, (void*)(uintptr_t)ch);
+  armVoice(ch, ms + FADE_SLACK_MS);   // ISR 누락 대비
+}
 
-    if (!s_enabled) {
-      // disable 중이면 명령 drop
-      continue;
+void voiceEnd(uint8_t ch, uint32_t now, bool expired) {
+  Voice& v = s_voice[ch];
+  if (!v.active) return;
+  esp_timer_stop(v.tmr);
+  if (ch == CH_LRA && v.lra == LRA_RTP) {
+    esp_timer_stop(s_rtp.tmr);
+    drvWrite(DRV_REG_RTP, 0);
+    drvWrite(DRV_REG_MODE, DRV_MODE_INTTRIG);
+  } else if (ch == CH_LRA) {
+    if (!expired) {   // 중간 정지만 DRV2605 정지(만료는 효과가 스스로 끝남)
+      HapticsRuntime::i2cLock();
+      s_drv.stop();
+      HapticsRuntime::i2cUnlock();
     }
+  } else {
+    ermCommit(ch, now);
+    ermFadeStop(ch);
+    ermWrite(ch, 0);
+  }
+  v.active = false;
+}
+
+// 겹침 규칙: prio 높으면 교체, 낮으면 무시, 같으면 max(level)·늦은 종료
+// 반환: 시작/갱신했으면 true
+bool voiceMix(uint8_t ch, uint8_t prio, uint16_t& level, uint32_t& endMs, bool maxLevel) {
+  Voice& v = s_voice[ch];
+  if (!v.active) return true;
+  if (prio < v.prio) return false;
+  if (ch == CH_LRA && v.lra == LRA_RTP) {
+    // 스트림은 합성 불가: 같은 우선순위는 무시, 높으면 스트림 종료 후 교체
+    if (prio == v.prio) return false;
+    voiceEnd(CH_LRA, millis(), false);
+    return true;
+  }
+  if (prio == v.prio) {
+    if (maxLevel && v.level > level) level = v.level;
+    if (before(endMs, v.endMs)) endMs = v.endMs;
+  }
+  return true;
+}
+
+// 다음 단계로(페이드 완료/타이머 공통). 세그먼트가 아직 안 끝났으면 무시 — 늦은 이벤트에 안전
+void ermAdvance(uint8_t ch, uint32_t now) {
+  Voice& v = s_voice[ch];
+  if (!v.active) return;
+  const uint32_t relAt = v.endMs - v.releaseMs;
+  if (v.stage == ERM_SUSTAIN) {
+    if (before(now, relAt)) { armVoice(ch, relAt - now); return; }
+  } else if (v.segMs && before(now, v.t0 + v.segMs)) {
+    return;
+  }
+  ermCommit(ch, now);
+  switch (v.stage) {
+    case ERM_ATTACK:
+      if (v.decayMs) { ermSegment(ch, ERM_DECAY, v.to, v.sustain, v.decayMs, now); return; }
+      // fallthrough
+    case ERM_DECAY:
+      ermSegment(ch, ERM_SUSTAIN, v.sustain, v.sustain, 0, now);
+      if (before(now, relAt)) { armVoice(ch, relAt - now); return; }
+      // fallthrough
+    case ERM_SUSTAIN:
+      if (v.releaseMs && v.to) { ermSegment(ch, ERM_RELEASE, v.to, 0, v.releaseMs, now); return; }
+      // fallthrough
+    default:
+      voiceEnd(ch, now, true);
+      return;
+  }
+}
+
+void ermStart(uint8_t ch, const HCmdERM& e, uint8_t prio, uint32_t now) {
+  uint16_t duty  = e.duty;
+  uint32_t endMs = now + e.ms;
+  if (!voiceMix(ch, prio, duty, endMs, true)) return;
+  Voice& v = s_voice[ch];
+  const uint8_t pct = (e.sustainPct > 100) ? 100 : e.sustainPct;
+
+  // 같은 우선순위 합성: 진행 중인 엔벨로프는 이어가고 레벨 상향·종료 연장만
+  //  - 주기적으로 다시 게시되는 요청(IMU 경고 등)이 매번 attack을 재시작하지 않게
+  //  - 릴리스 중이면 아래에서 현재 듀티부터 새로 시작
+  if (v.active && prio == v.prio && v.stage != ERM_RELEASE) {
+    v.endMs = endMs;                      // relAt(= endMs - releaseMs)도 함께 늦춰짐
+    if (duty > v.level) {                 // voiceMix가 max를 취했으므로 같거나 큼
+      const uint16_t s = (uint16_t)((uint32_t)duty * pct / 100u);
+      v.level = duty;
+      if (s > v.sustain) v.sustain = s;
+      ermCommit(ch, now);                 // from = 현재 듀티, segMs = 남은 구간
+      if (v.stage == ERM_ATTACK)     ermSegment(ch, ERM_ATTACK, v.from, duty, v.segMs, now);
+      else if (v.stage == ERM_DECAY) ermSegment(ch, ERM_DECAY, v.from, v.sustain, v.segMs, now);
+      else                           ermSegment(ch, ERM_SUSTAIN, v.sustain, v.sustain, 0, now);
+      if (!v.segMs) ermAdvance(ch, now);
+    } else if (v.stage == ERM_SUSTAIN) {
+      ermAdvance(ch, now);                // 늦춰진 relAt으로 타이머 재무장
+    }
+    return;
+  }
+
+  const uint16_t cur = v.active ? ermDutyAt(v, now) : 0;
+  ermCommit(ch, now);
+
+  // 단계 배분: attack → release → decay 순으로 전체 길이 안에 맞춤
+  const uint32_t total = endMs - now;
+  const uint32_t a = (e.attackMs < total) ? e.attackMs : total;
+  const uint32_t r = (e.releaseMs < total - a) ? e.releaseMs : total - a;
+  const uint32_t d = (e.decayMs < total - a - r) ? e.decayMs : total - a - r;
+
+  v.active    = true;
+  v.prio      = prio;
+  v.level     = duty;
+  v.endMs     = endMs;
+  v.sustain   = (uint16_t)((uint32_t)duty * pct / 100u);
+  v.decayMs   = (uint16_t)d;
+  v.releaseMs = (uint16_t)r;
+  // 교체/릴리스 중 합성은 현재 듀티에서 이어서 attack
+  ermSegment(ch, ERM_ATTACK, cur, duty, a, now);
+  if (!v.segMs) ermAdvance(ch, now);
+}
+
+void lraStart(uint8_t effect, uint32_t ms, uint8_t prio, uint32_t now) {
+  uint16_t eff = effect;
+  uint32_t endMs = now + ms;
+  if (!voiceMix(CH_LRA, prio, eff, endMs, false)) return;
+  Voice& v = s_voice[CH_LRA];
+  v.active = true;
+  v.prio   = prio;
+  v.level  = eff;
+  v.endMs  = endMs;
+  v.nextMs = now + LRA_RETRIGGER_MS;
+  v.lra    = LRA_EFFECT;
+  lraGo((uint8_t)eff);
+  armVoice(CH_LRA, before(v.nextMs, endMs) ? LRA_RETRIGGER_MS : endMs - now);
+}
+
+void seqStart(const uint8_t* slot, uint8_t prio, uint32_t now) {
+  uint16_t lvl = 0;
+  uint32_t endMs = now + seqMs(slot);
+  if (!voiceMix(CH_LRA, prio, lvl, endMs, false)) return;
+  Voice& v = s_voice[CH_LRA];
+  v.active = true;
+  v.prio   = prio;
+  v.level  = 0;
+  v.endMs  = endMs;
+  v.nextMs = endMs;
+  v.lra    = LRA_SEQ;
+  lraBurst(slot);
+  armVoice(CH_LRA, endMs - now);
+}
+
+void rtpArm(uint16_t rateHz) {
+  esp_timer_stop(s_rtp.tmr);
+  s_rtp.rateHz = rateHz;
+  esp_timer_start_periodic(s_rtp.tmr, 1000000u / rateHz);
+}
 
-    if (cmd.type == HCmdType::ERM) {
-      uint32_t dur = cmd.u.erm.ms;
-      uint16_t dt  = cmd.u.erm.duty;
-      ErmDir   dir = cmd.u.erm.dir;
-
-      // 정책 적용(퓨즈/하한/클램프)
-      const uint32_t now = millis();
-      if (!HapticsPolicy::fuseCheckAndAdjust(dir, now, dur, dt)) {
-        // soft mute 또는 hard cooldown → 실행 거부
-        continue;
-      }
-
-      // 실행
-      const uint32_t t0 = millis();
-      switch (dir) {
-        case ErmDir::LEFT:  ermWrite(true, dt);  ermWrite(false, 0);  break;
-        case ErmDir::RIGHT: ermWrite(true, 0);   ermWrite(false, dt); break;
-        case ErmDir::BOTH:  ermWrite(true, dt);  ermWrite(false, dt); break;
-      }
-      while (millis() - t0 < dur) { vTaskDelay(pdMS_TO_TICKS(5)); }
-      if (dir == ErmDir::LEFT)       ermWrite(true, 0);
-      else if (dir == ErmDir::RIGHT) ermWrite(false, 0);
-      else                           ermStopAll();
-
-      HapticsPolicy::fuseAccumulate(dir, dur, dt);
+void rtpStart(uint16_t rateHz, bool loop, uint8_t prio) {
+  Voice& v = s_voice[CH_LRA];
+  if (v.active && v.lra == LRA_RTP) {
+    // 재생 중: 주기/반복만 갱신(엔벨로프 교체는 다음 tick에서)
+    if (prio > v.prio) v.prio = prio;
+    s_rtp.loop = loop;
+    if (rateHz != s_rtp.rateHz) rtpArm(rateHz);
+    return;
+  }
+  if (v.active) {
+    if (prio < v.prio) return;
+    voiceEnd(CH_LRA, millis(), false);   // 효과/시퀀스 중단 후 RTP로 전환
+  }
+  drvWrite(DRV_REG_RTP, 0);
+  drvWrite(DRV_REG_MODE, DRV_MODE_RTP);
+  v.active = true;
+  v.prio   = prio;
+  v.lra    = LRA_RTP;
+  s_rtp.idx  = 0;
+  s_rtp.last = 0;
+  s_rtp.loop = loop;
+  rtpArm(rateHz);
+}
+
+// RTP 샘플 1개: 엔벨로프 교체 확인 → 값이 바뀔 때만 RTP 레지스터 쓰기
+void rtpTick() {
+  Voice& v = s_voice[CH_LRA];
+  if (!v.active || v.lra != LRA_RTP) return;
+
+  uint8_t st = s_envState.load();
+  while ((st & ENV_PENDING) && !(st & ENV_BUSY)) {
+    if (s_envState.compare_exchange_weak(st, (uint8_t)((st & ENV_FRONT) ^ ENV_FRONT))) { s_rtp.idx = 0; break; }
+  }
+  const uint8_t  f   = s_envState.load() & ENV_FRONT;
+  const uint16_t len = s_envLen[f];
+  if (s_rtp.idx >= len) {
+    if (!s_rtp.loop || !len) { voiceEnd(CH_LRA, millis(), true); return; }
+    s_rtp.idx = 0;
+  }
+  const uint8_t a = s_env[f][s_rtp.idx++];
+  if (a != s_rtp.last) {
+    drvWrite(DRV_REG_RTP, a);
+    s_rtp.last = a;
+  }
+}
+
+// 타이머 이벤트: 남은 시간 기준으로 재판정(늦게 도착한 이전 타이머 이벤트도 안전)
+void voiceTick(uint8_t ch, uint32_t now) {
+  Voice& v = s_voice[ch];
+  if (!v.active) return;
+  if (ch == CH_LRA && v.lra == LRA_RTP) return;   // 스트림은 RTP 타이머가 구동(이전 효과의 늦은 이벤트 무시)
+  if (ch != CH_LRA) { ermAdvance(ch, now); return; }
+  if (!before(now, v.endMs)) { voiceEnd(ch, v.endMs, true); return; }
+  if (ch == CH_LRA && v.lra == LRA_EFFECT && !before(now, v.nextMs)) {
+    lraGo((uint8_t)v.level);
+    v.nextMs = now + LRA_RETRIGGER_MS;
+  }
+  const uint32_t due = (ch == CH_LRA && before(v.nextMs, v.endMs)) ? v.nextMs : v.endMs;
+  armVoice(ch, due - now);
+}
+
+// 타이머/페이드/RTP 이벤트(알림 비트)
+void handleEvents(uint32_t ev, uint32_t now) {
+  if (ev & EV_RTP) rtpTick();
+  for (uint8_t ch = 0; ch < CH_COUNT; ++ch) {
+    if (ev & (EV_TICK0 << ch)) voiceTick(ch, now);
+    if (ev & (EV_FADE0 << ch)) ermAdvance(ch, now);
+  }
+}
+
+void handleCmd(const HCmd& cmd, uint32_t now) {
+  if (cmd.type == HCmdType::STOP) { voiceEnd(cmd.ch, now, false); return; }
+
+  if (!s_enabled) {
+    // disable 중이면 재생 명령 drop
+    return;
+  }
+
+  if (cmd.type == HCmdType::ERM) {
+    uint32_t dur = cmd.u.erm.ms;
+    uint16_t dt  = cmd.u.erm.duty;
+    ErmDir   dir = cmd.u.erm.dir;
+
+    // 정책 적용(퓨즈/하한/클램프)
+    if (!HapticsPolicy::fuseCheckAndAdjust(dir, now, dur, dt)) {
+      // soft mute 또는 hard cooldown → 실행 거부
+      return;
     }
-    else if (cmd.type == HCmdType::LRA) {
-      if (!s_lraReady) continue;
-
-      const uint32_t t0  = millis();
-      const uint32_t dur = HapticsPolicy::clampMs(cmd.u.lra.ms);
-      const uint8_t  eff = cmd.u.lra.effect;
-
-      constexpr uint32_t LRA_RETRIGGER_MS = 300; // 재트리거 템포
-
-      while (millis() - t0 < dur) {
-        HapticsRuntime::i2cLock();
-        s_drv.setWaveform(0, eff);
-        s_drv.setWaveform(1, 0);
-        s_drv.go();
-        HapticsRuntime::i2cUnlock();
-
-        const uint32_t remain = dur - (millis() - t0);
-        const uint32_t waitMs = (remain < LRA_RETRIGGER_MS) ? remain : LRA_RETRIGGER_MS;
-        vTaskDelay(pdMS_TO_TICKS(waitMs));
-      }
+    HCmdERM e = cmd.u.erm;
+    e.ms = dur; e.duty = dt;
+    if (dir != ErmDir::RIGHT) ermStart(CH_L, e, cmd.prio, now);
+    if (dir != ErmDir::LEFT)  ermStart(CH_R, e, cmd.prio, now);
+  }
+  else if (cmd.type == HCmdType::LRA) {
+    if (!s_lraReady) return;
+    lraStart(cmd.u.lra.effect, HapticsPolicy::clampMs(cmd.u.lra.ms), cmd.prio, now);
+  }
+  else if (cmd.type == HCmdType::SEQ) {
+    if (!s_lraReady) return;
+    seqStart(cmd.u.seq.slot, cmd.prio, now);
+  }
+  else if (cmd.type == HCmdType::RTP) {
+    if (!s_lraReady) return;
+    rtpStart(cmd.u.rtp.rateHz, cmd.u.rtp.loop, cmd.prio);
+  }
+}
+
+void taskHaptics(void*) {
+  for(;;) {
+    uint32_t ev = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &ev, portMAX_DELAY);
+    for(;;) {
+      handleEvents(ev, millis());
+      HCmd cmd;
+      if (xQueueReceive(s_qHaptics, &cmd, 0) != pdTRUE) break;
+      handleCmd(cmd, millis());
+      // 명령 사이에 도착한 타이머 이벤트를 다음 명령보다 먼저 처리
+      ev = 0;
+      xTaskNotifyWait(0, UINT32_MAX, &ev, 0);
     }
   }
 }
 
+bool post(const HCmd& c, bool front) {
+  if (!s_qHaptics) return false;
+  if ((front ? xQueueSendToFront(s_qHaptics, &c, 0) : xQueueSend(s_qHaptics, &c, 0)) != pdTRUE) return false;
+  if (s_taskHapt) xTaskNotify(s_taskHapt, EV_CMD, eSetBits);
+  return true;
+}
+
 } // namespace (anonymous)
 
 // ====== 공개 구현 ======
@@ -134,8 +529,8 @@ void begin() {
   s_i2cMutex = xSemaphoreCreateMutex();
 
   // ERM PWM attach (보드 핀은 HAL::Pin 사용)
-  ledcAttach(Pin::MOTOR_LEFT,  ERM_PWM_FREQ, ERM_PWM_RES_BITS);
-  ledcAttach(Pin::MOTOR_RIGHT, ERM_PWM_FREQ, ERM_PWM_RES_BITS);
+  ledcAttachChannel(Pin::MOTOR_LEFT,  ERM_PWM_FREQ, ERM_PWM_RES_BITS, ERM_LEDC_CH[CH_L]);
+  ledcAttachChannel(Pin::MOTOR_RIGHT, ERM_PWM_FREQ, ERM_PWM_RES_BITS, ERM_LEDC_CH[CH_R]);
   ermStopAll();
 
   // DRV2605L init (HAL의 Wire 공유)
@@ -149,10 +544,27 @@ void begin() {
     s_drv.useLRA();
     s_drv.selectLibrary(6);
     s_drv.setMode(DRV2605_MODE_INTTRIG);
+    // RTP 진폭은 부호 없는 0..255로
+    s_drv.writeRegister8(DRV_REG_CONTROL3, s_drv.readRegister8(DRV_REG_CONTROL3) | DRV_C3_RTP_UNSIGNED);
   }
   i2cUnlock();
   s_lraReady = ok;
 
+  // 채널 타이머(종료/재트리거)
+  for (uint8_t ch = 0; ch < CH_COUNT; ++ch) {
+    esp_timer_create_args_t ta = {};
+    ta.callback = &onVoiceTimer;
+    ta.arg      = (void*)(uintptr_t)ch;
+    ta.name     = "hapVoice";
+    esp_timer_create(&ta, &s_voice[ch].tmr);
+  }
+  {
+    esp_timer_create_args_t ta = {};
+    ta.callback = &onRtpTimer;
+    ta.name     = "hapRtp";
+    esp_timer_create(&ta, &s_rtp.tmr);
+  }
+
   // 큐/태스크
   s_qHaptics = xQueueCreate(16, sizeof(HCmd));
   xTaskCreatePinnedToCore(taskHaptics, "Haptics", 4096, nullptr, 3, &s_taskHapt, 1);
@@ -165,34 +577,96 @@ SemaphoreHandle_t i2cMutex() { return s_i2cMutex; }
 void i2cLock()   { if (s_i2cMutex) xSemaphoreTake(s_i2cMutex, portMAX_DELAY); }
 void i2cUnlock() { if (s_i2cMutex) xSemaphoreGive(s_i2cMutex); }
 
-bool ErmPlay(ErmDir dir, uint32_t ms, uint16_t duty) {
+bool ErmPlay(ErmDir dir, uint32_t ms, uint16_t duty, uint8_t prio) {
+  return ErmPlayEnv(dir, ms, duty, ErmEnvelope{}, prio);
+}
+
+bool ErmPlayEnv(ErmDir dir, uint32_t ms, uint16_t duty, const ErmEnvelope& env, uint8_t prio) {
   if (!s_enabled) return false;
-  HCmd c; c.type = HCmdType::ERM;
+  HCmd c{}; c.type = HCmdType::ERM; c.prio = prio;
+  c.u.erm.attackMs   = env.attackMs;
+  c.u.erm.decayMs    = env.decayMs;
+  c.u.erm.releaseMs  = env.releaseMs;
+  c.u.erm.sustainPct = env.sustainPct;
   c.u.erm.dir  = dir;
   c.u.erm.ms   = HapticsPolicy::clampMs(ms);
   // UX 하한(정책도 최종 보정하지만, 큐 진입 전 1차 보정)
   const uint16_t minDuty = HapticsPolicy::pctToDuty(HapticsPolicy::getErmMinPct());
   if (duty < minDuty) duty = minDuty;
   c.u.erm.duty = HapticsPolicy::clampDuty(duty);
-  return (xQueueSend(s_qHaptics, &c, 0) == pdTRUE);
+  return post(c, false);
 }
 
-bool LraPlay(uint32_t ms, uint8_t effect) {
+bool LraPlay(uint32_t ms, uint8_t effect, uint8_t prio) {
   if (!s_enabled) return false;
   if (!s_lraReady) {
     // LRA 불가 시 ERM 폴백
     const uint16_t duty = HapticsPolicy::effectToDuty(effect);
-    return ErmPlay(ErmDir::BOTH, HapticsPolicy::clampMs(ms), duty);
+    return ErmPlay(ErmDir::BOTH, HapticsPolicy::clampMs(ms), duty, prio);
   }
-  HCmd c; c.type = HCmdType::LRA;
+  HCmd c{}; c.type = HCmdType::LRA; c.prio = prio;
   c.u.lra.ms = HapticsPolicy::clampMs(ms);
   c.u.lra.effect = effect;
-  return (xQueueSend(s_qHaptics, &c, 0) == pdTRUE);
+  return post(c, false);
+}
+
+bool LraSequence(const uint8_t* slots, uint8_t n, uint8_t prio) {
+  if (!s_enabled || !slots || !n) return false;
+  HCmd c{}; c.type = HCmdType::SEQ; c.prio = prio;
+  if (n > LRA_SLOTS) n = LRA_SLOTS;
+  for (uint8_t i = 0; i < n; ++i) c.u.seq.slot[i] = slots[i];   // 나머지 0 = 끝
+  if (!s_lraReady) {
+    // LRA 불가 시 ERM 폴백(첫 효과 강도, 전체 추정 길이)
+    uint8_t eff = 0;
+    for (uint8_t i = 0; i < n && !eff; ++i) if (!(slots[i] & 0x80)) eff = slots[i];
+    if (!eff) return false;
+    return ErmPlay(ErmDir::BOTH, HapticsPolicy::clampMs(seqMs(c.u.seq.slot)), HapticsPolicy::effectToDuty(eff), prio);
+  }
+  return post(c, false);
+}
+
+bool LraStream(const uint8_t* amp, uint16_t n, uint16_t rateHz, bool loop, uint8_t prio) {
+  if (!s_enabled || !s_lraReady || !amp || !n) return false;
+  if (n > RTP_MAX_POINTS) n = RTP_MAX_POINTS;
+  if (rateHz < 50)   rateHz = 50;
+  if (rateHz > 1000) rateHz = 1000;
+
+  // 뒤 버퍼 작성(BUSY 동안 소비자는 교체하지 않음)
+  const uint8_t st = s_envState.fetch_or(ENV_BUSY);
+  if (st & ENV_BUSY) return false;
+  const uint8_t back = (uint8_t)((st & ENV_FRONT) ^ ENV_FRONT);
+  memcpy(s_env[back], amp, n);
+  s_envLen[back] = n;
+  s_envState.fetch_or(ENV_PENDING);
+  s_envState.fetch_and((uint8_t)~ENV_BUSY);
+
+  HCmd c{}; c.type = HCmdType::RTP; c.prio = prio;
+  c.u.rtp.rateHz = rateHz;
+  c.u.rtp.loop   = loop;
+  return post(c, false);
+}
+
+bool lraStreaming() {
+  const Voice& v = s_voice[CH_LRA];
+  return v.active && v.lra == LRA_RTP;
+}
+
+void stop(Channel ch) {
+  if (ch >= Channel::COUNT) return;
+  // 대기 중인 재생 명령보다 먼저 처리
+  HCmd c{}; c.type = HCmdType::STOP; c.ch = (uint8_t)ch;
+  // 큐가 가득 차면 PWM만 즉시 정지 — 진행 중인 LEDC 페이드가 듀티를 다시 올리지 않게 먼저 끊음
+  if (!post(c, true) && ch != Channel::LRA) {
+    ermFadeStop((uint8_t)ch);
+    ermWrite((uint8_t)ch, 0);
+  }
 }
 
 void stopAll() {
   // 큐 flush는 하지 않음(필요시 xQueueReset 고려)
-  ermStopAll();
+  stop(Channel::ERM_LEFT);
+  stop(Channel::ERM_RIGHT);
+  stop(Channel::LRA);
 }
 
 bool getErmFuse(float &loadL, float &loadR, long &cooldownLeftMs) {
@@ -201,6 +675,10 @@ bool getErmFuse(float &loadL, float &loadR, long &cooldownLeftMs) {
   return true;
 }
 
+bool channelActive(Channel ch) {
+  return (ch < Channel::COUNT) && s_voice[(uint8_t)ch].active;
+}
+
 bool lraReady() { return s_lraReady; }
 
 } // namespace HapticsRuntime
@@ -1,8 +1,15 @@
 #pragma once
 //
 // HapticsRuntime.h — 하프틱 런타임(큐/태스크/DRV2605L/I2C 뮤텍스)
-//  - 비동기 실행(TaskHaptics)
+//  - 비동기 실행(TaskHaptics) — 채널 믹서: ERM-L / ERM-R / LRA 독립 타임라인
+//      · 명령은 큐에서 꺼내는 즉시 시작(태스크는 알림 대기 외에 블로킹 없음)
+//      · 종료/LRA 재트리거는 채널별 esp_timer 원샷 → 태스크 알림 비트(큐가 차도 유실 없음) → 태스크에서 처리
+//      · 같은 채널 겹침: 높은 우선순위가 교체, 낮은 우선순위는 무시, 같으면 max(듀티)·늦은 종료로 합성
+//      · ERM 퓨즈는 실제 구동한 세그먼트(듀티 × 시간)만 채널별로 적산
 //  - ERM PWM 구동 / LRA(Drv2605) 구동
+//      · ERM 엔벨로프(ADSR): 램프는 LEDC 하드웨어 페이드, 단계 전환은 페이드 완료 ISR → 알림 비트
+//      · 파형 시퀀서: 슬롯 0x04..0x0B + GO(0x0C)를 자동 증가 I2C 버스트 1회로 기록(재트리거도 동일)
+//      · RTP 스트리밍: 진폭 엔벨로프를 고정 주기(esp_timer)로 RTP 레지스터(0x02) 단일 쓰기
 //  - 마스터 enable 스위치
 //  - I2C 공유용 내부 뮤텍스 제공
 //
@@ -35,13 +42,54 @@ SemaphoreHandle_t i2cMutex();
 void i2cLock();
 void i2cUnlock();
 
+// ====== 채널/우선순위 ======
+enum class Channel : uint8_t { ERM_LEFT = 0, ERM_RIGHT = 1, LRA = 2, COUNT };
+
+inline constexpr uint8_t PRIO_LOW    = 0;
+inline constexpr uint8_t PRIO_NORMAL = 1;
+inline constexpr uint8_t PRIO_HIGH   = 2;
+
+// ERM 엔벨로프: 0 → duty(attack) → duty·sustain%(decay) → 유지 → 0(release)
+//  - attack/decay/release는 ms(전체 길이) 안에서 배분(넘치면 attack → release → decay 순으로 자름)
+//  - 모두 0이면 기존 사각 펄스
+struct ErmEnvelope {
+  uint16_t attackMs   = 0;
+  uint16_t decayMs    = 0;
+  uint8_t  sustainPct = 100;
+  uint16_t releaseMs  = 0;
+};
+
 // ====== 공개 API ======
-bool ErmPlay(HapticsPolicy::ErmDir dir, uint32_t ms, uint16_t duty);
-bool LraPlay(uint32_t ms, uint8_t effect);
+bool ErmPlay(HapticsPolicy::ErmDir dir, uint32_t ms, uint16_t duty, uint8_t prio = PRIO_NORMAL);
+bool ErmPlayEnv(HapticsPolicy::ErmDir dir, uint32_t ms, uint16_t duty, const ErmEnvelope& env,
+                uint8_t prio = PRIO_NORMAL);
+bool LraPlay(uint32_t ms, uint8_t effect, uint8_t prio = PRIO_NORMAL);
+void stop(Channel ch);      // 해당 채널만 정지(나머지 채널은 계속)
+
+// LRA 파형 시퀀스(DRV2605 슬롯 최대 8개, 0 = 끝)
+//  - 슬롯 값: 1..123 효과 번호, bit7 = 대기(하위 7비트 × 10ms) — lraWait()
+//  - 슬롯+GO를 버스트 1회로 쓰고 GO 한 번: 효과 간 간격이 칩 타이밍 그대로
+//  - LRA 불가 시 첫 효과 기준 ERM 폴백(전체 길이 추정)
+inline constexpr uint8_t LRA_SLOTS = 8;
+inline constexpr uint8_t lraWait(uint16_t ms) { return (uint8_t)(0x80 | ((ms / 10 > 127) ? 127 : ms / 10)); }
+bool LraSequence(const uint8_t* slots, uint8_t n, uint8_t prio = PRIO_NORMAL);
+
+// LRA 실시간 재생(RTP): 진폭 엔벨로프(0..255, 최대 RTP_MAX_POINTS점)를 rateHz로 스트리밍
+//  - 이중 버퍼: 호출자는 뒤 버퍼에 복사만 하고 반환(블로킹 없음), 다음 RTP tick에서 교체 → 처음부터 재생
+//  - 재생 중 재호출 = 엔벨로프 교체(게임 구동 연속 진동), loop면 끝에서 반복, 아니면 끝나면 정지
+//  - LRA 채널을 점유: 같거나 낮은 우선순위 LRA 효과/시퀀스는 무시, 높으면 스트림을 끊고 재생
+//  - 동시에 여러 생산자가 호출하면 늦게 온 쪽은 false(버퍼 작성 중)
+//  - 정지: stop(Channel::LRA)
+inline constexpr uint16_t RTP_MAX_POINTS = 512;
+inline constexpr uint16_t RTP_RATE_HZ    = 200;
+bool LraStream(const uint8_t* amp, uint16_t n, uint16_t rateHz = RTP_RATE_HZ, bool loop = false,
+               uint8_t prio = PRIO_NORMAL);
+bool lraStreaming();
 void stopAll();
 
 // ====== 상태 조회 ======
 bool getErmFuse(float &loadL, float &loadR, long &cooldownLeftMs);
+bool channelActive(Channel ch);
 
 // 내부 테스트/디버그용(선택적)
 bool lraReady();
@@ -146,7 +146,7 @@ void taskReact(void*) {
     // XY 우선
     if (stateXY) {
       if (cntXY >= s_params.maxBursts) {
-        HapticsRuntime::ErmPlay(HapticsPolicy::ErmDir::BOTH, s_params.ermBothMs, s_params.ermEscDuty);
+        HapticsRuntime::ErmPlayEnv(HapticsPolicy::ErmDir::BOTH, s_params.ermBothMs, s_params.ermEscDuty, s_params.ermEscEnv);
         lraInhibitUntil = now + s_params.ermBothMs;
         cntXY = s_params.maxBursts;
       } else if (lraAllowed && (now - lastPlayXY >= s_params.repeatMs)) {
@@ -160,7 +160,7 @@ void taskReact(void*) {
       // X
       if (stateX) {
         if (cntX >= s_params.maxBursts) {
-          HapticsRuntime::ErmPlay(HapticsPolicy::ErmDir::LEFT, s_params.ermSingleMs, s_params.ermEscDuty);
+          HapticsRuntime::ErmPlayEnv(HapticsPolicy::ErmDir::LEFT, s_params.ermSingleMs, s_params.ermEscDuty, s_params.ermEscEnv);
           lraInhibitUntil = now + s_params.ermSingleMs;
           cntX = s_params.maxBursts;
         } else if (lraAllowed && (now - lastPlayX >= s_params.repeatMs)) {
@@ -174,7 +174,7 @@ void taskReact(void*) {
       // Y
       if (stateY) {
         if (cntY >= s_params.maxBursts) {
-          HapticsRuntime::ErmPlay(HapticsPolicy::ErmDir::RIGHT, s_params.ermSingleMs, s_params.ermEscDuty);
+          HapticsRuntime::ErmPlayEnv(HapticsPolicy::ErmDir::RIGHT, s_params.ermSingleMs, s_params.ermEscDuty, s_params.ermEscEnv);
           lraInhibitUntil = now + s_params.ermSingleMs;
           cntY = s_params.maxBursts;
         } else if (lraAllowed && (now - lastPlayY >= s_params.repeatMs)) {
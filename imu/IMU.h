@@ -8,6 +8,7 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "../haptics/HapticsRuntime.h"
 
 namespace IMU {
 
@@ -42,6 +43,8 @@ struct ReactParams {
   uint32_t ermSingleMs  = 1500;  // X/Y 단일 에스컬레이션
   uint32_t ermBothMs    = 5000;  // XY 동시 에스컬레이션
   uint16_t ermEscDuty   = 700;   // 0..1023 (정책 하한에 의해 상향될 수 있음)
+  // 에스컬레이션 엔벨로프: 급발진 대신 램프 인 → 70% 유지 → 램프 아웃
+  HapticsRuntime::ErmEnvelope ermEscEnv = { 150, 250, 70, 300 };
 };
 
 // 파라미터 설정/조회
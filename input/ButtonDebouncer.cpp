@@ -0,0 +1,67 @@
+#include "ButtonDebouncer.h"
+
+namespace {
+
+// 수직 카운터 평면: 비트 i의 카운트 = c3[i]c2[i]c1[i]c0[i]
+uint32_t s_c0 = 0, s_c1 = 0, s_c2 = 0, s_c3 = 0;
+uint32_t s_state = 0;
+
+uint8_t s_pressN   = 2;
+uint8_t s_releaseN = 2;
+
+// 카운트 == n 인 비트 마스크
+inline uint32_t countEq(uint8_t n){
+  return ((n & 1) ? s_c0 : ~s_c0)
+       & ((n & 2) ? s_c1 : ~s_c1)
+       & ((n & 4) ? s_c2 : ~s_c2)
+       & ((n & 8) ? s_c3 : ~s_c3);
+}
+
+} // anon
+
+namespace Debounce {
+
+void configure(uint8_t pressTicks, uint8_t releaseTicks, bool eager){
+  if (pressTicks   < 1) pressTicks   = 1;
+  if (releaseTicks < 1) releaseTicks = 1;
+  if (pressTicks   > MAX_TICKS) pressTicks   = MAX_TICKS;
+  if (releaseTicks > MAX_TICKS) releaseTicks = MAX_TICKS;
+  s_pressN   = eager ? 1 : pressTicks;
+  s_releaseN = releaseTicks;
+  // 임계를 낮추면 이미 임계를 넘은 카운터가 countEq에 걸리지 않고 랩어라운드 → 진행 중 카운트는 버림
+  s_c0 = s_c1 = s_c2 = s_c3 = 0;
+}
+
+uint8_t msToTicks(uint16_t ms, uint16_t rateHz){
+  if (!ms) return 0;
+  const uint32_t t = ((uint32_t)ms * rateHz + 999u) / 1000u;
+  return (uint8_t)((t < 1) ? 1 : (t > MAX_TICKS) ? MAX_TICKS : t);
+}
+
+uint32_t update(uint32_t raw){
+  const uint32_t diff = raw ^ s_state;
+
+  // 다른 비트만 +1 (리플 캐리), 같은 비트는 0으로 리셋
+  const uint32_t k1 = s_c0;
+  const uint32_t k2 = s_c1 & k1;
+  const uint32_t k3 = s_c2 & k2;
+  s_c0 = ~s_c0      & diff;
+  s_c1 = (s_c1 ^ k1) & diff;
+  s_c2 = (s_c2 ^ k2) & diff;
+  s_c3 = (s_c3 ^ k3) & diff;
+
+  // 방향별 임계 도달 → 전환 + 카운터 클리어
+  const uint32_t hit = diff & ((~s_state & countEq(s_pressN)) | (s_state & countEq(s_releaseN)));
+  s_state ^= hit;
+  s_c0 &= ~hit; s_c1 &= ~hit; s_c2 &= ~hit; s_c3 &= ~hit;
+  return s_state;
+}
+
+void reset(uint32_t level){
+  s_c0 = s_c1 = s_c2 = s_c3 = 0;
+  s_state = level;
+}
+
+uint32_t state(){ return s_state; }
+
+} // namespace Debounce
@@ -0,0 +1,30 @@
+#pragma once
+//
+// ButtonDebouncer — 전체 버튼 일괄 디바운스(32비트 마스크, 비트 병렬 수직 카운터)
+//  - 비트마다 4비트 카운터(c0..c3 평면) → 버튼 수와 무관하게 tick당 정수 연산 몇십 개
+//  - raw가 안정 상태와 다른 샘플이 연속 N회면 상태 전환, 같아지면 카운터 리셋
+//  - 누름/뗌 임계(틱 단위)를 따로 설정. eager: 누름은 즉시 반영, 뗌만 디바운스
+//
+
+#include <stdint.h>
+
+namespace Debounce {
+
+// 카운터 최대값(4비트)
+inline constexpr uint8_t MAX_TICKS = 15;
+
+// 임계치 설정(틱 단위, 0/1 = 즉시). 안정 상태는 유지, 진행 중 카운터는 초기화
+void configure(uint8_t pressTicks, uint8_t releaseTicks, bool eager);
+
+// ms → 틱 변환 헬퍼(올림, 1..MAX_TICKS로 클램프, 0ms는 0)
+uint8_t msToTicks(uint16_t ms, uint16_t rateHz);
+
+// 샘플 1회 반영 → 디바운스된 레벨 반환
+uint32_t update(uint32_t raw);
+
+// 상태/카운터 초기화(부팅 시 현재 레벨로 시작하면 가짜 에지 방지)
+void reset(uint32_t level = 0);
+
+uint32_t state();
+
+} // namespace Debounce
@@ -1,35 +1,83 @@
 #include "GamepadPipeline.h"
 #include "../hal/HAL.h"
 #include "../usb/USBDevices.h"
-#include "../haptics/HapticsRuntime.h"
 #include "../core/ConfigStore.h"
 #include "../core/Log.h"
+#include "StickShaping.h"
+#include "StickAutoCal.h"
+
+#include <atomic>
 
 namespace {
 
+using namespace StickShaping;
+
+// 축별 보정값 — StickAutoCal(저장값/온라인 추적)에서 채움
 struct JoyCalib {
   int minX=300, centerX=2048, maxX=3800;
   int minY=300, centerY=2048, maxY=3800;
 };
 
 struct StickState {
-  float xEma=0.f, yEma=0.f;
+  int32_t xEma=0, yEma=0;   // Q15 (필터 출력 — EMA/1€ 공용)
+  OneEuro::Filter fx, fy;
 };
 
 struct State {
   JoyCalib L, R;
+  AxisNorm nLX, nLY, nRX, nRY;   // 캘리브레이션 → 정규화 계수 캐시
   StickState Ls, Rs;
-  uint32_t lastSend=0;
-  int8_t lastX=0, lastY=0, lastRX=0, lastRY=0;
-  uint32_t lastBtns=0;
   uint32_t l3r3PressMs=0;
+  uint64_t lastTickUs=0;         // 1€ 필터 dt
 } S;
 
-constexpr uint32_t SEND_INTERVAL_MS = 5;
+// 센터 재보정 상태 머신: Idle → Sampling(N샘플, GAP 간격) → Finish(초록 LED 유지) → Idle
+enum class CalPhase : uint8_t { Idle, Sampling, Finish };
+
+struct CalState {
+  CalPhase phase = CalPhase::Idle;
+  bool     blinkRed = true;
+  bool     redOn = false;
+  uint16_t finishGreenMs = 0;
+  uint16_t count = 0;
+  uint32_t nextSampleMs = 0;
+  uint32_t lastToggleMs = 0;
+  uint32_t finishUntilMs = 0;
+  long     sumLX=0, sumLY=0, sumRX=0, sumRY=0;
+} C;
+
+constexpr uint16_t CAL_SAMPLES   = 100;
+constexpr uint16_t CAL_GAP_MS    = 20;    // 100 × 20ms ≈ 2s 평균(기존과 동일)
+constexpr uint16_t CAL_BLINK_MS  = 500;
+
+Gamepad::CalCb s_calCb;
+
+// CLI 등 다른 태스크에서 요청한 보정값 초기화 — 입력 태스크 tick에서 처리
+volatile bool s_resetCalReq = false;
+
+constexpr int32_t JOY_EMA_ALPHA_Q15 = Q15_ONE / 4;   // 0.25
+
+// 필터 단계(기본: 기존 EMA)
+uint8_t         s_fMode = OneEuro::MODE_EMA;
+OneEuro::Params s_fp{ 2.0f, 1.0f, 1.0f };
+
+inline float   q15ToF(int32_t v){ return (float)v * (1.0f / (float)Q15_ONE); }
+inline int32_t fToQ15(float f){
+  const float s = f * (float)Q15_ONE;
+  return (int32_t)((s >= 0.0f) ? (s + 0.5f) : (s - 0.5f));
+}
+
+inline void filterAxis(int32_t in, int32_t& out, OneEuro::Filter& f, float dtS){
+  if (s_fMode == OneEuro::MODE_ONE_EURO) out = fToQ15(f.step(q15ToF(in), dtS, s_fp));
+  else                                   emaQ15(JOY_EMA_ALPHA_Q15, in, out);
+}
 
-constexpr float JOY_DEADZONE  = 0.15f;
-constexpr float JOY_GAMMA     = 1.4f;
-constexpr float JOY_EMA_ALPHA = 0.25f;
+// 응답 곡선 LUT: 기본값은 플래시(constexpr), 설정 변경 시 RAM 버퍼에 생성 후 게시
+//  - 생성은 설정 태스크, 게시는 입력 태스크 → 게시된 것 / 게시 대기 중(마지막 생성)인 것을 피해야 하므로 3개
+//  - 입력 태스크는 tick마다 포인터를 acquire로 한 번 읽어 그 테이블만 사용
+Lut s_lutRam[3]{};
+std::atomic<const Lut*> s_lut{ &kDefaultLut };
+const Lut* s_lutBuilt = &kDefaultLut;   // 설정 태스크 전용
 
 // 축 반전(필요하면 Config로 이동 가능)
 constexpr bool INVERT_LX = true;
@@ -37,54 +85,62 @@ constexpr bool INVERT_LY = false;
 constexpr bool INVERT_RX = true;
 constexpr bool INVERT_RY = false;
 
-float normalizeAxis(int raw, int minV, int cenV, int maxV){
-  if (raw < minV) raw = minV;
-  if (raw > maxV) raw = maxV;
-  float halfSpan = (float)(maxV - minV) * 0.5f;
-  float mid      = (float)cenV;
-  float val      = ((float)raw - mid) / halfSpan;   // -1..+1
-  if (val >  1.f) val =  1.f;
-  if (val < -1.f) val = -1.f;
-  return val;
+// 센터 기준 양쪽을 각각 ±1로(자동 보정 범위는 비대칭일 수 있음)
+void prepareNorm(){
+  axisPrepareSplit(S.nLX, S.L.minX, S.L.centerX, S.L.maxX);
+  axisPrepareSplit(S.nLY, S.L.minY, S.L.centerY, S.L.maxY);
+  axisPrepareSplit(S.nRX, S.R.minX, S.R.centerX, S.R.maxX);
+  axisPrepareSplit(S.nRY, S.R.minY, S.R.centerY, S.R.maxY);
 }
 
-void shapeStick(float& x, float& y){
-  float r = sqrtf(x*x + y*y);
-  if (r < JOY_DEADZONE){ x=0.f; y=0.f; return; }
-  float s = (r - JOY_DEADZONE) / (1.f - JOY_DEADZONE);
-  if (s < 0.f) s = 0.f; if (s > 1.f) s = 1.f;
-  float k = (r > 0.f) ? (s / r) : 0.f;
-  x *= k; y *= k;
-  auto curve = [](float v){
-    float a = fabsf(v);
-    float o = powf(a, JOY_GAMMA);
-    return (v >= 0.f) ? o : -o;
-  };
-  x = curve(x); y = curve(y);
-  const float rr = sqrtf(x*x + y*y);
-  if (rr > 1.f){ x/=rr; y/=rr; }
+void loadCal(){
+  using namespace StickAutoCal;
+  const ConfigStore::StickCal& c = current();
+  S.L.minX = c.minV[LX]; S.L.centerX = c.cenV[LX]; S.L.maxX = c.maxV[LX];
+  S.L.minY = c.minV[LY]; S.L.centerY = c.cenV[LY]; S.L.maxY = c.maxV[LY];
+  S.R.minX = c.minV[RX]; S.R.centerX = c.cenV[RX]; S.R.maxX = c.maxV[RX];
+  S.R.minY = c.minV[RY]; S.R.centerY = c.cenV[RY]; S.R.maxY = c.maxV[RY];
+  prepareNorm();
 }
 
-inline void ema2(float a, float inX, float inY, float& sX, float& sY){
-  sX = sX + a * (inX - sX);
-  sY = sY + a * (inY - sY);
-}
+// 재보정 1스텝(tick에서 호출). Sampling 중이면 true(축 중립 유지)
+bool calStep(const HAL::SticksRaw& r, uint32_t now_ms){
+  if (C.phase == CalPhase::Finish){
+    if ((int32_t)(now_ms - C.finishUntilMs) >= 0){
+      HAL::ledG(false);
+      C.phase = CalPhase::Idle;
+    }
+    return false;
+  }
+  if (C.phase != CalPhase::Sampling) return false;
 
-inline int8_t toI8(float v){
-  if (v >  1.f) v =  1.f;
-  if (v < -1.f) v = -1.f;
-  return (int8_t)lroundf(v * 127.0f);
-}
+  if (C.blinkRed && now_ms - C.lastToggleMs >= CAL_BLINK_MS){
+    C.redOn = !C.redOn; HAL::ledR(C.redOn); C.lastToggleMs = now_ms;
+  }
+
+  if ((int32_t)(now_ms - C.nextSampleMs) < 0) return true;
+  C.nextSampleMs += CAL_GAP_MS;
+  C.sumLX += r.lx; C.sumLY += r.ly; C.sumRX += r.rx; C.sumRY += r.ry;
+  if (++C.count < CAL_SAMPLES) return true;
 
-void sendIfChanged(int8_t X,int8_t Y,int8_t RX,int8_t RY,uint32_t btns,uint32_t now){
-  const bool moved = (X!=S.lastX)||(Y!=S.lastY)||(RX!=S.lastRX)||(RY!=S.lastRY)||(btns!=S.lastBtns);
-  if (!moved) return;
-  if (now - S.lastSend < SEND_INTERVAL_MS) return;
+  // 센터 교체 + 저장 스테이징(범위는 자동 보정값 유지)
+  StickAutoCal::setCenters((int)(C.sumLX / CAL_SAMPLES), (int)(C.sumLY / CAL_SAMPLES),
+                           (int)(C.sumRX / CAL_SAMPLES), (int)(C.sumRY / CAL_SAMPLES));
+  loadCal();
+  S.Ls = StickState{}; S.Rs = StickState{};   // 새 센터 기준으로 EMA 재시작
 
-  USBDevices::gamepadSend(X, Y, RX, RY, btns);
+  HAL::ledR(false);
+  if (C.finishGreenMs){
+    HAL::ledG(true);
+    C.finishUntilMs = now_ms + C.finishGreenMs;
+    C.phase = CalPhase::Finish;
+  } else {
+    C.phase = CalPhase::Idle;
+  }
 
-  S.lastX=X; S.lastY=Y; S.lastRX=RX; S.lastRY=RY; S.lastBtns=btns;
-  S.lastSend = now;
+  LOGI("GP", "centers L(%d,%d) R(%d,%d)", S.L.centerX, S.L.centerY, S.R.centerX, S.R.centerY);
+  if (s_calCb) s_calCb(Gamepad::CalEvent::Done);
+  return false;
 }
 
 } // anon
@@ -93,57 +149,81 @@ namespace Gamepad {
 
 void init(){
   S = State{};
+  StickAutoCal::init();
+  loadCal();
 }
 
-void recalibrateCenters(bool blinkRed, uint16_t finishGreenMs){
-  LOGI("GP", "center calibration start");
-  uint32_t lastToggle = millis();
-  bool redOn = false;
-
-  const int N = 100;
-  const uint16_t GAP_MS = 20;
-  const uint16_t BLINK_MS = 500;
-
-  long sumLX=0, sumLY=0, sumRX=0, sumRY=0;
-  for(int i=0;i<N;i++){
-    HAL::SticksRaw r; HAL::readSticksRaw(r);
-    sumLX += r.lx; sumLY += r.ly; sumRX += r.rx; sumRY += r.ry;
-
-    if (blinkRed){
-      if (millis() - lastToggle >= BLINK_MS){
-        redOn = !redOn; HAL::ledR(redOn); lastToggle = millis();
-      }
-    }
-    delay(GAP_MS);
+void setFilter(uint8_t mode, const OneEuro::Params& p){
+  s_fp = p;
+  if (mode != s_fMode){
+    // 모드 전환 시 1€ 상태를 현재 출력에서 다시 시작(점프 방지)
+    S.Ls.fx.prime(q15ToF(S.Ls.xEma), p.minCutoff); S.Ls.fy.prime(q15ToF(S.Ls.yEma), p.minCutoff);
+    S.Rs.fx.prime(q15ToF(S.Rs.xEma), p.minCutoff); S.Rs.fy.prime(q15ToF(S.Rs.yEma), p.minCutoff);
+    s_fMode = mode;
   }
+}
 
-  S.L.centerX = (int)(sumLX / N);
-  S.L.centerY = (int)(sumLY / N);
-  S.R.centerX = (int)(sumRX / N);
-  S.R.centerY = (int)(sumRY / N);
+uint8_t filterMode(){ return s_fMode; }
 
-  HAL::ledR(false);
-  if (finishGreenMs){
-    HAL::ledG(true);
-    HapticsRuntime::LraPlay(220, 10);
-    delay(finishGreenMs);
-    HAL::ledG(false);
+void filterCutoffs(float out[4]){
+  const bool oe = (s_fMode == OneEuro::MODE_ONE_EURO);
+  out[0] = oe ? S.Ls.fx.fc : 0.0f;
+  out[1] = oe ? S.Ls.fy.fc : 0.0f;
+  out[2] = oe ? S.Rs.fx.fc : 0.0f;
+  out[3] = oe ? S.Rs.fy.fc : 0.0f;
+}
+
+void setAutoCal(bool en){ StickAutoCal::setEnabled(en); }
+
+void resetCalibration(){ s_resetCalReq = true; }
+
+const Lut* buildCurve(float deadzone, float gamma){
+  const double dz = static_cast<double>(deadzone);
+  const double g  = static_cast<double>(gamma);
+  if (fabs(dz - DEFAULT_DEADZONE) < 1e-4 && fabs(g - DEFAULT_GAMMA) < 1e-4){
+    s_lutBuilt = &kDefaultLut;
+    return s_lutBuilt;
   }
+  // 게시 중인 테이블도, 아직 게시 대기 중일 수 있는 직전 생성본도 아닌 버퍼에 생성
+  const Lut* live = s_lut.load(std::memory_order_acquire);
+  Lut* back = &s_lutRam[0];
+  while (back == live || back == s_lutBuilt) ++back;
+  *back = makeLut(dz, g);
+  s_lutBuilt = back;
+  LOGI("GP", "curve dz=%.2f gamma=%.2f (LUT rebuilt)", dz, g);
+  return back;
+}
 
-  USBDevices::gamepadSend(0,0,0,0,0); // 중립 리포트
-  S.lastX=S.lastY=S.lastRX=S.lastRY=0; S.lastBtns=0; S.lastSend=millis();
+void setCurveLut(const Lut* lut){
+  if (lut) s_lut.store(lut, std::memory_order_release);
+}
 
-  LOGI("GP", "centers L(%d,%d) R(%d,%d)", S.L.centerX, S.L.centerY, S.R.centerX, S.R.centerY);
+bool recalibrateCenters(bool blinkRed, uint16_t finishGreenMs){
+  if (C.phase == CalPhase::Sampling) return false;
+  C = CalState{};
+  C.phase         = CalPhase::Sampling;
+  C.blinkRed      = blinkRed;
+  C.finishGreenMs = finishGreenMs;
+  C.nextSampleMs  = millis();
+  C.lastToggleMs  = C.nextSampleMs;
+  LOGI("GP", "center calibration start");
+  if (s_calCb) s_calCb(CalEvent::Started);
+  return true;
 }
 
-void tick(uint32_t now_ms){
+bool isCalibrating(){ return C.phase == CalPhase::Sampling; }
+
+void setCalibrationCallback(CalCb cb){ s_calCb = cb; }
+
+void tick(const HAL::InputFrame& in, uint32_t now_ms){
+  using HAL::Button;
+  using HAL::buttonBit;
+
   // L3+R3 1초 → 재보정
-  const bool l3 = HAL::pressed(HAL::Button::L3);
-  const bool r3 = HAL::pressed(HAL::Button::R3);
-  if (l3 && r3){
+  if (in.all(buttonBit(Button::L3) | buttonBit(Button::R3))){
     if (!S.l3r3PressMs) S.l3r3PressMs = now_ms;
     if (now_ms - S.l3r3PressMs > 1000){
-      recalibrateCenters(true, 600);
+      recalibrateCenters(true, 600);   // 진행 중이면 무시
       S.l3r3PressMs = now_ms; // 반복 방지 최소 지연
     }
   } else {
@@ -152,42 +232,62 @@ void tick(uint32_t now_ms){
 
   HAL::SticksRaw raw; HAL::readSticksRaw(raw);
 
-  float nlx = normalizeAxis(raw.lx, S.L.minX,S.L.centerX,S.L.maxX);
-  float nly = normalizeAxis(raw.ly, S.L.minY,S.L.centerY,S.L.maxY);
-  float nrx = normalizeAxis(raw.rx, S.R.minX,S.R.centerX,S.R.maxX);
-  float nry = normalizeAxis(raw.ry, S.R.minY,S.R.centerY,S.R.maxY);
+  uint32_t btns = 0;
+  if (in.down(Button::A))  btns |= (1u<<0);
+  if (in.down(Button::B))  btns |= (1u<<1);
+  if (in.down(Button::X))  btns |= (1u<<2);
+  if (in.down(Button::Y))  btns |= (1u<<3);
+  if (in.down(Button::L3)) btns |= (1u<<8);
+  if (in.down(Button::R3)) btns |= (1u<<9);
+
+  // 재보정 중: 샘플만 모으고 축은 중립 고정(버튼은 그대로 전달)
+  if (calStep(raw, now_ms)){
+    USBDevices::gamepadSet(0, 0, 0, 0, btns);
+    return;
+  }
+
+  if (s_resetCalReq){
+    s_resetCalReq = false;
+    StickAutoCal::reset();
+    loadCal();
+  }
+
+  // 온라인 자동 보정(극값 확장/센터 드리프트) — 바뀐 경우에만 정규화 계수 재계산
+  if (StickAutoCal::update(raw, now_ms)) loadCal();
 
-  // 원래 구현처럼 XY swap
-  { float t=nlx; nlx=nly; nly=t; }
-  { float t=nrx; nrx=nry; nry=t; }
+  // 원래 구현처럼 XY swap (X ← Y축 raw)
+  int32_t nlx = normalizeQ15(raw.ly, S.nLY);
+  int32_t nly = normalizeQ15(raw.lx, S.nLX);
+  int32_t nrx = normalizeQ15(raw.ry, S.nRY);
+  int32_t nry = normalizeQ15(raw.rx, S.nRX);
 
   if (INVERT_LX) nlx = -nlx;
   if (INVERT_LY) nly = -nly;
   if (INVERT_RX) nrx = -nrx;
   if (INVERT_RY) nry = -nry;
 
-  ema2(JOY_EMA_ALPHA, nlx, nly, S.Ls.xEma, S.Ls.yEma);
-  ema2(JOY_EMA_ALPHA, nrx, nry, S.Rs.xEma, S.Rs.yEma);
-
-  float fx=S.Ls.xEma, fy=S.Ls.yEma;
-  float gx=S.Rs.xEma, gy=S.Rs.yEma;
-  shapeStick(fx, fy);
-  shapeStick(gx, gy);
-
-  const int8_t X  = toI8(fx);
-  const int8_t Y  = toI8(fy);
-  const int8_t RX = toI8(gx);
-  const int8_t RY = toI8(gy);
-
-  uint32_t btns = 0;
-  if (HAL::pressed(HAL::Button::A))  btns |= (1u<<0);
-  if (HAL::pressed(HAL::Button::B))  btns |= (1u<<1);
-  if (HAL::pressed(HAL::Button::X))  btns |= (1u<<2);
-  if (HAL::pressed(HAL::Button::Y))  btns |= (1u<<3);
-  if (HAL::pressed(HAL::Button::L3)) btns |= (1u<<8);
-  if (HAL::pressed(HAL::Button::R3)) btns |= (1u<<9);
-
-  sendIfChanged(X, Y, RX, RY, btns, now_ms);
+  const float dtS = S.lastTickUs ? (float)(uint32_t)(in.t_us - S.lastTickUs) * 1e-6f : 0.0f;
+  S.lastTickUs = in.t_us;
+  filterAxis(nlx, S.Ls.xEma, S.Ls.fx, dtS);
+  filterAxis(nly, S.Ls.yEma, S.Ls.fy, dtS);
+  filterAxis(nrx, S.Rs.xEma, S.Rs.fx, dtS);
+  filterAxis(nry, S.Rs.yEma, S.Rs.fy, dtS);
+
+  int32_t fx=S.Ls.xEma, fy=S.Ls.yEma;
+  int32_t gx=S.Rs.xEma, gy=S.Rs.yEma;
+  const Lut& lut = *s_lut.load(std::memory_order_acquire);
+  shapeQ15(fx, fy, lut);
+  shapeQ15(gx, gy, lut);
+
+  // Q15 그대로 전달 — int8 변환은 표준 리포트 모드일 때만 USBDev에서(고해상도 모드는 손실 없음)
+  // 트리거 입력 하드웨어가 없어 LT/RT는 0
+  const int16_t X  = q15ToI16(fx);
+  const int16_t Y  = q15ToI16(fy);
+  const int16_t RX = q15ToI16(gx);
+  const int16_t RY = q15ToI16(gy);
+
+  // 리포트 상태만 갱신 — 변경 여부/전송 간격은 USBDev::flush가 판단
+  USBDevices::gamepadSet(X, Y, RX, RY, btns);
 }
 
 } // namespace Gamepad
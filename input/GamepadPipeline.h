@@ -1,16 +1,49 @@
 #pragma once
 //
 // GamepadPipeline — 스틱/버튼 → v3.x 리포트 (드리프트 보정/EMA/감마/원형클램프)
+//  - 정규화/셰이핑은 Q15 고정소수점 + LUT (StickShaping.h)
 //
 
 #include <stdint.h>
+#include <functional>
+#include "../hal/HAL.h"
+#include "OneEuroFilter.h"
+
+namespace StickShaping { struct Lut; }
 
 namespace Gamepad {
 
 void init();
-void tick(uint32_t now_ms);
+void tick(const HAL::InputFrame& in, uint32_t now_ms);
+
+// 응답 곡선(반경 데드존 0..0.95, 감마) 변경 — 두 단계로 분리(LUT 생성은 double 반복 연산이라 수 ms)
+//  - buildCurve: 호출 태스크(CLI/loop)에서 게시되지 않은 RAM 버퍼에 LUT 생성, 완성된 테이블 반환
+//    (기본값이면 플래시 테이블). 생성 요청은 한 태스크에서만
+//  - setCurveLut: 입력 태스크에서 포인터만 게시
+const StickShaping::Lut* buildCurve(float deadzone, float gamma);
+void setCurveLut(const StickShaping::Lut* lut);
+
+// 스틱 필터 단계: OneEuro::MODE_EMA(고정 α=0.25) / OneEuro::MODE_ONE_EURO(속도 적응형)
+// 1€ 파라미터 단위: 정규화 축(-1..+1), 속도 = 단위/s
+void setFilter(uint8_t mode, const OneEuro::Params& p);
+uint8_t filterMode();
+// 축별 마지막 유효 컷오프(Hz): LX, LY, RX, RY (EMA 모드면 0)
+void filterCutoffs(float out[4]);
+
+// 수동 센터 재보정(제스처/버튼 조합에서 호출 가능) — 비블로킹
+//  - 호출 즉시 반환, 이후 tick마다 샘플을 모아 완료 시 센터 교체
+//  - 진행 중에는 스틱 축을 중립(0)으로 고정, 버튼은 그대로 전달
+//  - LED(빨강 점멸 → 초록 유지)는 tick에서 처리, 완료는 이벤트 콜백으로 통지
+//  - 이미 진행 중이면 false
+bool recalibrateCenters(bool blinkRed=true, uint16_t finishGreenMs=600);
+bool isCalibrating();
+
+// 온라인 자동 보정(StickAutoCal) on/off, 보정값 초기화(기본 범위로 돌아가 다시 학습, 다음 tick에서 적용)
+void setAutoCal(bool en);
+void resetCalibration();
 
-// 수동 센터 재보정(제스처/버튼 조합에서 호출 가능)
-void recalibrateCenters(bool blinkRed=true, uint16_t finishGreenMs=600);
+enum class CalEvent : uint8_t { Started, Done };
+using CalCb = std::function<void(CalEvent)>;
+void setCalibrationCallback(CalCb cb);
 
 } // namespace Gamepad
@@ -10,7 +10,6 @@ namespace {
 
 Gesture::FactoryCb s_cb;
 
-constexpr uint32_t HOLD_DEBOUNCE_MS = 10;
 constexpr uint32_t HOLD_MIN_MS      = 2500;
 constexpr uint32_t HOLD_MAX_MS      = 6200;
 
@@ -19,11 +18,25 @@ constexpr uint32_t HAPTIC_TOGGLE_HOLD_MS = 3000;
 // 부팅 팩토리 윈도우
 constexpr uint32_t FACTORY_WINDOW_MS = 10000;
 constexpr uint32_t FACTORY_HOLD_MS   = 2500;
+constexpr uint32_t FACTORY_SELECT_MS = 3000;
+constexpr uint32_t FACTORY_HB_MS     = 500;
 uint32_t s_bootStartMs = 0;
-
-// 터치 홀드/디바운스
-bool     touchStable = false, touchLast = false;
-uint32_t touchLastChange = 0;
+bool     s_bootDone    = false;
+
+// 프로파일 선택창(콤보 유지 후 3초) — tick마다 한 스텝, 입력 태스크를 막지 않음
+bool     selActive  = false;
+uint32_t selStartMs = 0;
+uint32_t selHbMs    = 0;
+bool     selHbOn    = false;
+
+// 모드 토글 LED 안내(333ms 점등/소등 × 3) — tick마다 한 스텝
+constexpr uint32_t BLINK_STEP_MS = 333;
+uint8_t      blinkLeft   = 0;      // 남은 점등/소등 단계(짝수 = 다음이 점등)
+uint32_t     blinkNextMs = 0;
+Slider::Mode blinkM      = Slider::Mode::Wheel;
+
+// 터치 홀드(디바운스는 RuntimeInput의 버튼 디바운서가 담당)
+bool     touchStable = false;
 uint32_t touchPressStart = 0;
 
 // 하프틱 토글 콤보
@@ -36,21 +49,42 @@ uint8_t  tapCount=0;
 uint32_t lastTapMs=0;
 constexpr uint32_t TAP_WINDOW_MS=1800;
 
-inline bool allABXYPressed(){
-  return HAL::pressed(HAL::Button::A)
-      && HAL::pressed(HAL::Button::B)
-      && HAL::pressed(HAL::Button::X)
-      && HAL::pressed(HAL::Button::Y);
+constexpr uint32_t MASK_ABXY = HAL::buttonBit(HAL::Button::A) | HAL::buttonBit(HAL::Button::B)
+                             | HAL::buttonBit(HAL::Button::X) | HAL::buttonBit(HAL::Button::Y);
+constexpr uint32_t MASK_AY   = HAL::buttonBit(HAL::Button::A) | HAL::buttonBit(HAL::Button::Y);
+constexpr uint32_t MASK_BOOT = HAL::buttonBit(HAL::Button::L3) | HAL::buttonBit(HAL::Button::R3)
+                             | HAL::buttonBit(HAL::Button::A);
+
+void blinkMode(Slider::Mode m, uint32_t now_ms){
+  blinkM      = m;
+  blinkLeft   = 6;
+  blinkNextMs = now_ms;
+}
+
+void blinkStep(uint32_t now_ms){
+  if (!blinkLeft || (int32_t)(now_ms - blinkNextMs) < 0) return;
+  if (blinkLeft & 1u){ HAL::ledR(false); HAL::ledG(false); }
+  else if (blinkM==Slider::Mode::Zoom){ HAL::ledR(true);  HAL::ledG(false); }
+  else                                { HAL::ledR(false); HAL::ledG(true);  }
+  --blinkLeft;
+  blinkNextMs = now_ms + BLINK_STEP_MS;
 }
 
-void blinkMode(Slider::Mode m){
-  for(int i=0;i<3;i++){
-    if (m==Slider::Mode::Zoom){ HAL::ledR(true);  HAL::ledG(false); }
-    else                      { HAL::ledR(false); HAL::ledG(true);  }
-    delay(333);
-    HAL::ledR(false); HAL::ledG(false);
-    delay(333);
+// 선택창 1스텝: A=SMOKE, B=FULL(콤보에 A가 포함되므로 눌림 에지로 판단), 시간 초과 시 SMOKE
+void selectStep(const HAL::InputFrame& in, uint32_t now_ms){
+  using HAL::Button;
+  Gesture::FactoryEvent ev = Gesture::FactoryEvent::None;
+  if      (in.rose(Button::A)) ev = Gesture::FactoryEvent::Smoke;
+  else if (in.rose(Button::B)) ev = Gesture::FactoryEvent::Full;
+  else if (now_ms - selStartMs >= FACTORY_SELECT_MS) ev = Gesture::FactoryEvent::Smoke;   // 타임아웃 default
+
+  if (ev == Gesture::FactoryEvent::None){
+    if (now_ms - selHbMs >= FACTORY_HB_MS){ selHbOn = !selHbOn; HAL::ledB(selHbOn); selHbMs = now_ms; }
+    return;
   }
+  selActive = false;
+  HAL::ledB(false);
+  if (s_cb) s_cb(ev);
 }
 
 } // anon
@@ -60,31 +94,32 @@ namespace Gesture {
 void init(FactoryCb cb){
   s_cb = cb;
   s_bootStartMs = millis();
+  s_bootDone    = false;
+  selActive     = false;
+  blinkLeft     = 0;
 }
 
-void tick(uint32_t now_ms){
+void tick(const HAL::InputFrame& in, uint32_t now_ms){
+  using HAL::Button;
+
+  blinkStep(now_ms);
+
   // ---- 부팅 구간 팩토리 진입 ----
-  if (now_ms - s_bootStartMs < FACTORY_WINDOW_MS){
+  if (selActive){
+    selectStep(in, now_ms);
+  } else if (!s_bootDone && now_ms - s_bootStartMs < FACTORY_WINDOW_MS){
     static uint32_t holdStart=0;
-    const bool l3 = HAL::pressed(HAL::Button::L3);
-    const bool r3 = HAL::pressed(HAL::Button::R3);
-    const bool a  = HAL::pressed(HAL::Button::A);
-    if (l3 && r3 && a){
+    if (in.all(MASK_BOOT)){
       if (!holdStart) holdStart = now_ms;
       if (now_ms - holdStart >= FACTORY_HOLD_MS){
-        // 3초 간 선택창 — A=SMOKE, B=FULL
+        // 3초 간 선택창 — A=SMOKE, B=FULL (이후 tick에서 진행)
         LOGI("FACT", "boot-combo detected: select A=SMOKE, B=FULL within 3s");
-        const uint32_t selT = millis();
-        while(millis() - selT < 3000){
-          if (HAL::pressed(HAL::Button::A)){ if(s_cb) s_cb(FactoryEvent::Smoke); break; }
-          if (HAL::pressed(HAL::Button::B)){ if(s_cb) s_cb(FactoryEvent::Full);  break; }
-          static uint32_t hb=0; static bool on=false;
-          if(millis()-hb>500){ on=!on; HAL::ledB(on); hb=millis(); }
-          delay(5);
-        }
-        if (s_cb) s_cb(FactoryEvent::Smoke); // 타임아웃 default
+        selActive  = true;
+        selStartMs = now_ms;
+        selHbMs    = now_ms;
+        selHbOn    = false;
         // 부팅 창 종료
-        s_bootStartMs = 0;
+        s_bootDone = true;
       }
     } else {
       holdStart = 0;
@@ -93,60 +128,52 @@ void tick(uint32_t now_ms){
 
   // ---- 런타임 스모크 쇼트컷: “터치 3탭 + A&Y 유지” ----
   {
-    const bool ayHeld = (HAL::pressed(HAL::Button::A) && HAL::pressed(HAL::Button::Y));
-    static bool prevTouch=false;
-    const bool touch = HAL::pressed(HAL::Button::TouchDigital);
-    if (touch != prevTouch){
-      prevTouch = touch;
-      if (!touch){
-        if (ayHeld){
-          if (now_ms - lastTapMs > TAP_WINDOW_MS) tapCount=0;
-          tapCount++;
-          lastTapMs=now_ms;
-          if (tapCount>=3){
-            LOGI("FACT", "runtime shortcut: touch 3-tap + A&Y -> SMOKE");
-            if (s_cb) s_cb(FactoryEvent::Smoke);
-            tapCount=0;
-          }
-        } else {
+    const bool ayHeld = in.all(MASK_AY);
+    if (in.fell(Button::TouchDigital)){
+      if (ayHeld){
+        if (now_ms - lastTapMs > TAP_WINDOW_MS) tapCount=0;
+        tapCount++;
+        lastTapMs=now_ms;
+        if (tapCount>=3){
+          LOGI("FACT", "runtime shortcut: touch 3-tap + A&Y -> SMOKE");
+          if (s_cb) s_cb(FactoryEvent::Smoke);
           tapCount=0;
         }
+      } else {
+        tapCount=0;
       }
     }
   }
 
-  // ---- 터치 디바운스/홀드(모드 토글 & 하프틱 글로벌 토글) ----
+  // ---- 터치 홀드(모드 토글 & 하프틱 글로벌 토글) ----
   {
-    const bool reading = HAL::pressed(HAL::Button::TouchDigital);
-    if (reading != touchLast){ touchLastChange = now_ms; touchLast = reading; }
-    if ((now_ms - touchLastChange) > HOLD_DEBOUNCE_MS){
-      if (touchStable != reading){
-        touchStable = reading;
-
-        if (touchStable){
-          touchPressStart = now_ms;
-          hapticComboActive = false;
-          hapticComboStart  = 0;
-        } else {
-          // release
-          const uint32_t held = now_ms - touchPressStart;
-          if (now_ms - lastHapticToggleMs < 800) {
-            // 최근 글로벌 토글 후 바운스 윈도 — 무시
-          } else if (held >= HOLD_MIN_MS && held <= HOLD_MAX_MS){
-            // 모드 토글
-            Slider::Mode m = Slider::getMode();
-            m = (m==Slider::Mode::Wheel) ? Slider::Mode::Zoom : Slider::Mode::Wheel;
-            Slider::setMode(m);
-            blinkMode(m);
-            HapticsRuntime::LraPlay(120, 11);
-            LOGI("MODE", "toggled to %s", (m==Slider::Mode::Zoom?"Zoom":"Wheel"));
-          }
+    const bool reading = in.down(Button::TouchDigital);
+    if (touchStable != reading){
+      touchStable = reading;
+
+      if (touchStable){
+        touchPressStart = now_ms;
+        hapticComboActive = false;
+        hapticComboStart  = 0;
+      } else {
+        // release
+        const uint32_t held = now_ms - touchPressStart;
+        if (now_ms - lastHapticToggleMs < 800) {
+          // 최근 글로벌 토글 후 바운스 윈도 — 무시
+        } else if (held >= HOLD_MIN_MS && held <= HOLD_MAX_MS){
+          // 모드 토글
+          Slider::Mode m = Slider::getMode();
+          m = (m==Slider::Mode::Wheel) ? Slider::Mode::Zoom : Slider::Mode::Wheel;
+          Slider::setMode(m);
+          blinkMode(m, now_ms);
+          HapticsRuntime::LraPlay(120, 11);
+          LOGI("MODE", "toggled to %s", (m==Slider::Mode::Zoom?"Zoom":"Wheel"));
         }
       }
     }
 
     if (touchStable){
-      if (allABXYPressed()){
+      if (in.all(MASK_ABXY)){
         if (!hapticComboActive){
           hapticComboActive = true;
           hapticComboStart  = now_ms;
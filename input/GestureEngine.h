@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 #include <functional>
+#include "../hal/HAL.h"
 
 namespace Gesture {
 
@@ -18,6 +19,6 @@ enum class FactoryEvent : uint8_t { None, Smoke, Full };
 using FactoryCb = std::function<void(FactoryEvent)>;
 
 void init(FactoryCb cb);
-void tick(uint32_t now_ms);
+void tick(const HAL::InputFrame& in, uint32_t now_ms);
 
 } // namespace Gesture
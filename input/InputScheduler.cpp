@@ -0,0 +1,162 @@
+#include "InputScheduler.h"
+#include "RuntimeInput.h"
+
+#include "../core/Log.h"
+
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace {
+
+using InputScheduler::Stats;
+
+// 입력 태스크: 코어1, prio 4 (하프틱 3 / 벤더 2 / loop 1 보다 위 — tick은 짧게 유지)
+constexpr uint32_t    INPUT_TASK_STACK = 6144;
+constexpr UBaseType_t INPUT_TASK_PRIO  = 4;
+constexpr BaseType_t  INPUT_TASK_CORE  = 1;
+
+esp_timer_handle_t s_timer = nullptr;
+TaskHandle_t       s_task  = nullptr;
+
+volatile uint16_t s_rateHz   = InputScheduler::RATE_500HZ;
+volatile uint32_t s_periodUs = 1000000u / InputScheduler::RATE_500HZ;
+volatile bool     s_suspended = false;
+volatile bool     s_busy      = false;
+volatile uint64_t s_frameUs   = 0;
+
+// 다음 예정 웨이크업 시각(µs) — 타이머 (재)시작 시 기준점
+uint64_t s_dueUs = 0;
+
+Stats s_stats;
+
+inline bool validRate(uint16_t hz){
+  return hz == InputScheduler::RATE_250HZ || hz == InputScheduler::RATE_500HZ || hz == InputScheduler::RATE_1000HZ;
+}
+
+void onTimer(void*){
+  // esp_timer 태스크 컨텍스트(ESP_TIMER_TASK 디스패치)
+  if (s_task) xTaskNotifyGive(s_task);
+}
+
+void startTimer(){
+  s_dueUs = (uint64_t)esp_timer_get_time() + s_periodUs;
+  esp_timer_start_periodic(s_timer, s_periodUs);
+}
+
+inline void histAdd(uint32_t jitterUs){
+  uint8_t b = 0;
+  while (b < InputScheduler::JITTER_BINS - 1 && jitterUs >= InputScheduler::kJitterEdgesUs[b]) ++b;
+  s_stats.hist[b]++;
+}
+
+void taskInput(void*){
+  for(;;){
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (s_suspended) continue;
+
+    s_busy = true;
+    const uint64_t t = (uint64_t)esp_timer_get_time();
+    const uint32_t period = s_periodUs;
+
+    // 가장 가까운 예정 슬롯 기준 지터 + 놓친 주기 계산
+    uint32_t skipped = 0;
+    int64_t  late = (int64_t)(t - s_dueUs);
+    if (late > (int64_t)(period / 2)){
+      skipped = (uint32_t)((late + period / 2) / period);
+      late -= (int64_t)skipped * period;
+    }
+    const uint32_t jitter = (uint32_t)((late < 0) ? -late : late);
+    s_dueUs += (uint64_t)(skipped + 1) * period;
+
+    s_frameUs = t;
+    RuntimeInput::tick(t);
+
+    const uint32_t busy = (uint32_t)((uint64_t)esp_timer_get_time() - t);
+
+    s_stats.periods++;
+    s_stats.missed += skipped;
+    if (skipped || busy > period) s_stats.overruns++;
+    if (jitter > s_stats.maxJitterUs) s_stats.maxJitterUs = jitter;
+    if (busy   > s_stats.maxBusyUs)   s_stats.maxBusyUs   = busy;
+    s_stats.lastBusyUs = busy;
+    histAdd(jitter);
+
+    s_busy = false;
+  }
+}
+
+} // anon
+
+namespace InputScheduler {
+
+void begin(uint16_t rateHz){
+  if (s_timer) return;
+  if (!setRate(rateHz)) setRate(RATE_500HZ);
+
+  xTaskCreatePinnedToCore(taskInput, "Input", INPUT_TASK_STACK, nullptr,
+                          INPUT_TASK_PRIO, &s_task, INPUT_TASK_CORE);
+
+  esp_timer_create_args_t args = {};
+  args.callback        = &onTimer;
+  args.arg             = nullptr;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name            = "input";
+  if (esp_timer_create(&args, &s_timer) != ESP_OK){
+    LOGI("SCHED", "esp_timer_create failed");
+    return;
+  }
+  resetStats();
+  startTimer();
+  LOGI("SCHED", "started %u Hz (period %lu us)", (unsigned)s_rateHz, (unsigned long)s_periodUs);
+}
+
+bool setRate(uint16_t rateHz){
+  if (!validRate(rateHz)) return false;
+  if (rateHz == s_rateHz && s_timer) return true;
+
+  s_rateHz   = rateHz;
+  s_periodUs = 1000000u / rateHz;
+  s_stats.rateHz = rateHz;
+
+  if (s_timer && !s_suspended){
+    esp_timer_stop(s_timer);
+    startTimer();
+  }
+  return true;
+}
+
+uint16_t rate(){ return s_rateHz; }
+
+void suspend(){
+  if (s_suspended) return;
+  s_suspended = true;
+  if (s_timer) esp_timer_stop(s_timer);
+  // 호출자가 입력 태스크 자신이 아니면 진행 중인 tick 종료 대기
+  if (xTaskGetCurrentTaskHandle() != s_task){
+    while (s_busy) vTaskDelay(1);
+  }
+}
+
+void resume(){
+  if (!s_suspended) return;
+  s_suspended = false;
+  if (s_timer) startTimer();
+}
+
+bool isSuspended(){ return s_suspended; }
+
+uint64_t frameTimeUs(){ return s_frameUs; }
+
+void getStats(Stats& out){
+  out = s_stats;
+  out.rateHz = s_rateHz;
+}
+
+void resetStats(){
+  s_stats = Stats{};
+  s_stats.rateHz = s_rateHz;
+}
+
+} // namespace InputScheduler
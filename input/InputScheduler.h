@@ -0,0 +1,54 @@
+#pragma once
+//
+// InputScheduler — 하드웨어 타이머(esp_timer) 기반 고정 주기 입력 스케줄러
+//  - 주기 타이머가 전용 입력 태스크를 깨워 RuntimeInput::tick(now_us) 호출
+//  - 250/500/1000 Hz 선택, 타임스탬프는 esp_timer_get_time() (µs)
+//  - 주기별 오버런(처리시간 > 주기, 놓친 주기) 카운트 + 웨이크업 지터 히스토그램
+//  - 파이프라인별 분주비(Gesture/TouchPad/Slider/Gamepad)는 RuntimeInput::setDividers
+//
+
+#include <stdint.h>
+
+namespace InputScheduler {
+
+// 지원 주기
+inline constexpr uint16_t RATE_250HZ  = 250;
+inline constexpr uint16_t RATE_500HZ  = 500;
+inline constexpr uint16_t RATE_1000HZ = 1000;
+
+// 지터 히스토그램 구간 상한(µs): <25, <50, <100, <250, <500, <1000, 그 이상
+inline constexpr uint8_t  JITTER_BINS = 7;
+inline constexpr uint16_t kJitterEdgesUs[JITTER_BINS - 1] = { 25, 50, 100, 250, 500, 1000 };
+
+struct Stats {
+  uint16_t rateHz      = 0;
+  uint32_t periods     = 0;   // 실행한 주기 수
+  uint32_t overruns    = 0;   // 처리시간이 주기를 넘었거나 주기를 놓친 횟수
+  uint32_t missed      = 0;   // 건너뛴 주기 수(누적)
+  uint32_t maxJitterUs = 0;   // |실제 웨이크업 - 예정 시각| 최대
+  uint32_t maxBusyUs   = 0;   // tick 처리시간 최대
+  uint32_t lastBusyUs  = 0;
+  uint32_t hist[JITTER_BINS] = {0};
+};
+
+// 타이머/태스크 시작(RuntimeInput::init 이후)
+void begin(uint16_t rateHz = RATE_500HZ);
+
+// 주기 변경(250/500/1000만 허용). begin 전에 호출하면 시작 주기로 사용
+bool setRate(uint16_t rateHz);
+uint16_t rate();
+
+// 팩토리 테스트 등 HAL을 직접 점유하는 구간에서 입력 처리 일시 중지
+// suspend()는 진행 중인 tick이 끝날 때까지 기다린 뒤 반환
+void suspend();
+void resume();
+bool isSuspended();
+
+// 현재(또는 마지막) 프레임의 타임스탬프(µs)
+uint64_t frameTimeUs();
+
+// 통계
+void getStats(Stats& out);
+void resetStats();
+
+} // namespace InputScheduler
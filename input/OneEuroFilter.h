@@ -0,0 +1,57 @@
+#pragma once
+//
+// OneEuroFilter.h — 속도 적응형 1€ 필터(Casiez et al.)
+//  - 정지/저속: 컷오프 ≈ minCutoff → 지터 억제
+//  - 고속: 컷오프 = minCutoff + beta·|속도| → 지연 감소
+//  - 속도(미분)는 dCutoff로 한 번 더 저역통과
+//  - Arduino 의존성 없음(float 연산만, S3 단정밀 FPU 사용)
+//
+
+#include <stdint.h>
+
+namespace OneEuro {
+
+// 필터 모드(파이프라인 공통)
+enum : uint8_t { MODE_EMA = 0, MODE_ONE_EURO = 1 };   // 게임패드: EMA(기존) / 1€
+enum : uint8_t { MODE_OFF = 0 };                     // 터치패드: 필터 없음(기존) / 1€
+
+struct Params {
+  float minCutoff = 1.0f;   // Hz
+  float beta      = 0.0f;   // (Hz) / (단위/s)
+  float dCutoff   = 1.0f;   // Hz
+};
+
+inline float alpha(float cutoffHz, float dtS){
+  constexpr float TWO_PI = 6.28318530718f;
+  const float tau = 1.0f / (TWO_PI * cutoffHz);
+  return 1.0f / (1.0f + tau / dtS);
+}
+
+struct Filter {
+  float x  = 0.0f;      // 필터 출력
+  float dx = 0.0f;      // 필터된 속도(단위/s)
+  float fc = 0.0f;      // 마지막 유효 컷오프(Hz) — 조회용
+  bool  primed = false;
+
+  void reset(){ primed = false; dx = 0.0f; fc = 0.0f; }
+
+  void prime(float v, float minCutoff){
+    x = v; dx = 0.0f; fc = minCutoff; primed = true;
+  }
+
+  // v: 새 샘플, dtS: 직전 샘플과의 간격(s)
+  float step(float v, float dtS, const Params& p){
+    if (!primed || dtS <= 0.0f){
+      if (!primed) prime(v, p.minCutoff);
+      return x;
+    }
+    const float rawDx = (v - x) / dtS;
+    dx += alpha(p.dCutoff, dtS) * (rawDx - dx);
+    const float speed = (dx < 0.0f) ? -dx : dx;
+    fc = p.minCutoff + p.beta * speed;
+    x += alpha(fc, dtS) * (v - x);
+    return x;
+  }
+};
+
+} // namespace OneEuro
@@ -0,0 +1,82 @@
+#include "PointerBallistics.h"
+#include "OneEuroFilter.h"
+
+#include <math.h>
+#include <atomic>
+
+namespace {
+
+using PointerBallistics::LUT_N;
+
+struct Lut {
+  float mult[LUT_N];
+  float vMax;
+};
+
+// 이중 버퍼: 게시되지 않은 쪽에 생성 후 release로 교체(GamepadPipeline 곡선 LUT와 동일)
+Lut                    s_lutBuf[2];
+std::atomic<const Lut*> s_lut{ nullptr };   // nullptr = 가속 없음(배율 1)
+
+float s_speed = 0.0f;
+float s_mult  = 1.0f;
+float s_remX  = 0.0f, s_remY = 0.0f;
+
+inline int iround(float f){ return (int)((f>0)?(f+0.5f):(f-0.5f)); }
+
+float lookup(const Lut& l, float v){
+  float pos = v / l.vMax * (float)(LUT_N - 1);
+  if (pos <= 0.0f) return l.mult[0];
+  if (pos >= (float)(LUT_N - 1)) return l.mult[LUT_N - 1];
+  const uint8_t i = (uint8_t)pos;
+  const float   f = pos - (float)i;
+  return l.mult[i] + (l.mult[i + 1] - l.mult[i]) * f;
+}
+
+} // anon
+
+namespace PointerBallistics {
+
+void configure(const Params& p){
+  if (!p.enabled || !(p.vMax > 0.0f)){
+    s_lut.store(nullptr, std::memory_order_release);
+    return;
+  }
+  Lut& l = (s_lut.load(std::memory_order_acquire) == &s_lutBuf[0]) ? s_lutBuf[1] : s_lutBuf[0];
+  l.vMax = p.vMax;
+  for (uint8_t i = 0; i < LUT_N; ++i){
+    const float t = (float)i / (float)(LUT_N - 1);
+    l.mult[i] = p.accMin + (p.accMax - p.accMin) * powf(t, p.exp);
+  }
+  s_lut.store(&l, std::memory_order_release);
+}
+
+void reset(){
+  s_speed = 0.0f;
+  s_mult  = 1.0f;
+  s_remX = s_remY = 0.0f;
+}
+
+void step(float dxC, float dyC, float gain, float dtS, int& dx, int& dy){
+  const Lut* l = s_lut.load(std::memory_order_acquire);
+  float k = gain;
+  if (l && dtS > 0.0f){
+    const float v = sqrtf(dxC * dxC + dyC * dyC) / dtS;
+    s_speed += OneEuro::alpha(SPEED_CUTOFF_HZ, dtS) * (v - s_speed);
+    s_mult = lookup(*l, s_speed);
+    k *= s_mult;
+  } else if (!l) {
+    s_mult = 1.0f;
+  }
+
+  s_remX += dxC * k;
+  s_remY += dyC * k;
+  dx = iround(s_remX);
+  dy = iround(s_remY);
+  s_remX -= (float)dx;
+  s_remY -= (float)dy;
+}
+
+float speed(){ return s_speed; }
+float multiplier(){ return s_mult; }
+
+} // namespace PointerBallistics
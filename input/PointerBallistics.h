@@ -0,0 +1,41 @@
+#pragma once
+//
+// PointerBallistics — 터치 커서 가속 곡선 + 서브픽셀 나머지 이월
+//  - 입력: 셀 단위 이동량과 간격(s) → 속도(셀/s, 저역통과)로 LUT에서 배율을 읽어 게인에 곱함
+//  - 곡선: mult(v) = accMin + (accMax - accMin)·(v / vMax)^exp, v ≥ vMax는 accMax (LUT_N점 선형 보간)
+//      · 느린 이동: accMin < 1 → 정밀
+//      · 빠른 플릭: accMax > 1 → 손을 떼지 않고 화면 횡단
+//  - 출력은 정수 픽셀, 소수부는 다음 리포트로 이월(손가락을 떼면 reset)
+//  - LUT는 비활성 버퍼에 만든 뒤 포인터 교체(입력 태스크가 반쯤 쓰인 테이블을 보지 않음)
+//
+
+#include <stdint.h>
+
+namespace PointerBallistics {
+
+inline constexpr uint8_t LUT_N        = 33;
+inline constexpr float   SPEED_CUTOFF_HZ = 10.0f;   // 속도 저역통과
+
+struct Params {
+  bool  enabled = false;   // false = 배율 1(선형 게인)
+  float accMin  = 0.6f;
+  float accMax  = 3.0f;
+  float vMax    = 40.0f;   // 셀/s — accMax에 도달하는 속도
+  float exp     = 1.5f;    // 곡선 지수
+};
+
+// 곡선 설정(LUT 재생성)
+void configure(const Params& p);
+
+// 착지 시 호출: 속도/나머지 초기화
+void reset();
+
+// dxC/dyC: 셀 단위 이동(화면 방향 부호), gain: 셀당 픽셀, dtS: 직전 호출과 간격
+// 나머지 포함 정수 픽셀(dx, dy) 반환
+void step(float dxC, float dyC, float gain, float dtS, int& dx, int& dy);
+
+// 조회(CLI)
+float speed();        // 필터된 속도(셀/s)
+float multiplier();   // 마지막 배율
+
+} // namespace PointerBallistics
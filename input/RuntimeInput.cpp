@@ -3,15 +3,102 @@
 #include "SliderPipeline.h"
 #include "GamepadPipeline.h"
 #include "GestureEngine.h"
+#include "ButtonDebouncer.h"
+#include "InputScheduler.h"
+
+#include "../hal/HAL.h"
+#include "../usb/USBDevices.h"
+#include "../haptics/HapticsRuntime.h"
 
 #include "../core/ConfigStore.h"
 #include "../core/Log.h"
 
+#include "freertos/FreeRTOS.h"
+
 using RuntimeInput::FactoryAction;
 
 namespace {
   // 제스처가 올린 팩토리 이벤트를 버퍼링
   volatile FactoryAction g_pendingAction = FactoryAction::None;
+
+  // 분주비 + 주기 카운터
+  RuntimeInput::Dividers g_div;
+  uint32_t g_frame = 0;
+
+  inline bool due(uint8_t div){ return div <= 1 || (g_frame % div) == 0; }
+
+  // 입력 스냅샷: tick당 1회 생성. 분주 파이프라인은 건너뛴 프레임의 에지를 누적해서 받음
+  HAL::InputFrame g_in;
+  HAL::InputFrame g_inGesture, g_inTouch, g_inSlider, g_inGamepad;
+
+  // 디바운스 설정(ms) + 환산에 쓴 주기
+  uint16_t g_debPressMs = 5, g_debReleaseMs = 10;
+  bool     g_debEager = false;
+  uint16_t g_debHz = 0;
+
+  // 터치 수집 태스크에 알려 준 터치 tick 주기(µs) — 추적 읽기 주기를 여기에 맞춤
+  uint32_t g_touchTickUs = 0;
+
+  void applyDebounce(uint16_t hz){
+    Debounce::configure(Debounce::msToTicks(g_debPressMs, hz),
+                        Debounce::msToTicks(g_debReleaseMs, hz), g_debEager);
+    g_debHz = hz;
+  }
+
+  // 설정 핸드오프: 다른 태스크(CLI/loop)의 setter는 여기에 적재만 하고,
+  // 입력 태스크가 tick 맨 앞에서 한 번에 반영(파이프라인 라이브 상태는 입력 태스크만 씀)
+  enum : uint8_t {
+    ST_CURVE   = 1u << 0,
+    ST_AUTOCAL = 1u << 1,
+    ST_FILTERS = 1u << 2,
+    ST_ACCEL   = 1u << 3,
+    ST_DIV     = 1u << 4,
+    ST_DEB     = 1u << 5,
+  };
+  struct Staged {
+    const StickShaping::Lut* lut = nullptr;   // 설정 태스크에서 완성된 곡선 테이블
+    bool  autoCal = false;
+    uint8_t joyMode = 0, tpMode = 0;
+    OneEuro::Params joy, tp;
+    PointerBallistics::Params acc;
+    RuntimeInput::Dividers div;
+    uint16_t pressMs = 5, releaseMs = 10;
+    bool     eager = false;
+  };
+  portMUX_TYPE     g_stageMux = portMUX_INITIALIZER_UNLOCKED;
+  Staged           g_stage;
+  volatile uint8_t g_stageMask = 0;
+
+  void applyStaged(){
+    Staged s; uint8_t m;
+    portENTER_CRITICAL(&g_stageMux);
+    m = g_stageMask;
+    s = g_stage;
+    g_stageMask = 0;
+    portEXIT_CRITICAL(&g_stageMux);
+
+    if (m & ST_CURVE)   Gamepad::setCurveLut(s.lut);
+    if (m & ST_AUTOCAL) Gamepad::setAutoCal(s.autoCal);
+    if (m & ST_FILTERS){
+      Gamepad::setFilter(s.joyMode, s.joy);
+      TouchPad::setFilter(s.tpMode, s.tp);
+    }
+    if (m & ST_ACCEL)   TouchPad::setBallistics(s.acc);
+    if (m & ST_DIV)     g_div = s.div;
+    if (m & ST_DEB){
+      g_debPressMs   = s.pressMs;
+      g_debReleaseMs = s.releaseMs;
+      g_debEager     = s.eager;
+      g_debHz        = 0;          // 아래 주기 확인에서 재환산
+    }
+  }
+
+  inline void runDue(uint8_t div, HAL::InputFrame& acc, void (*fn)(const HAL::InputFrame&, uint32_t), uint32_t now_ms){
+    acc.merge(g_in);
+    if (!due(div)) return;
+    fn(acc, now_ms);
+    acc.clearEdges();
+  }
 }
 
 static void onFactoryEvent(Gesture::FactoryEvent ev){
@@ -22,21 +109,112 @@ static void onFactoryEvent(Gesture::FactoryEvent ev){
   }
 }
 
+static void onCalEvent(Gamepad::CalEvent ev){
+  // 재보정 완료 피드백(LRA) — 하프틱 큐로 넘기므로 입력 태스크는 블로킹되지 않음
+  if (ev == Gamepad::CalEvent::Done) HapticsRuntime::LraPlay(220, 10);
+}
+
 namespace RuntimeInput {
 
 void init() {
   TouchPad::init();
   Slider::init();
   Gamepad::init();
+  Gamepad::setCalibrationCallback(onCalEvent);
   Gesture::init(onFactoryEvent); // 팩토리 이벤트 콜백 등록
+
+  // 부팅 시 이미 눌린 버튼은 현재 레벨로 시작(가짜 pressed 에지 방지)
+  const uint32_t m = HAL::readButtonMask();
+  Debounce::reset(m);
+  g_in.update(m, 0);
+  g_in.clearEdges();
+  applyDebounce(InputScheduler::rate());
 }
 
-void tick(uint32_t now_ms) {
+void tick(uint64_t now_us) {
+  const uint32_t now_ms = (uint32_t)(now_us / 1000u);
+
+  // 적재된 설정 변경은 여기서만 반영(스케줄러의 s_busy 구간 안)
+  if (g_stageMask) applyStaged();
+
+  // 버튼 전체를 한 번에 샘플 → 디바운스 → 이번 tick의 모든 파이프라인이 공유
+  const uint16_t hz = InputScheduler::rate();
+  if (hz != g_debHz) applyDebounce(hz);
+  g_in.update(Debounce::update(HAL::readButtonMask()), now_us);
+  const uint32_t touchUs = hz ? (1000000u / hz) * (g_div.touchpad ? g_div.touchpad : 1u) : 0u;
+  if (touchUs != g_touchTickUs){ HAL::touchSetTickPeriod(touchUs); g_touchTickUs = touchUs; }
+
   // 순서: 제스처(모드/토글/진입) → 터치패드/슬라이더 → 게임패드
-  Gesture::tick(now_ms);
-  TouchPad::tick(now_ms);
-  Slider::tick(now_ms);
-  Gamepad::tick(now_ms);
+  runDue(g_div.gesture,  g_inGesture, Gesture::tick,  now_ms);
+  runDue(g_div.touchpad, g_inTouch,   TouchPad::tick, now_ms);
+  runDue(g_div.slider,   g_inSlider,  Slider::tick,   now_ms);
+  runDue(g_div.gamepad,  g_inGamepad, Gamepad::tick,  now_ms);
+
+  // 파이프라인이 기록한 리포트 상태를 인터페이스당 최대 1개 리포트로 전송
+  USBDevices::flush(now_ms);
+
+  g_frame++;
+}
+
+void setDividers(const Dividers& d){
+  Dividers v = d;
+  if (!v.gesture)  v.gesture  = 1;
+  if (!v.touchpad) v.touchpad = 1;
+  if (!v.slider)   v.slider   = 1;
+  if (!v.gamepad)  v.gamepad  = 1;
+  portENTER_CRITICAL(&g_stageMux);
+  g_stage.div  = v;
+  g_stageMask |= ST_DIV;
+  portEXIT_CRITICAL(&g_stageMux);
+}
+
+Dividers getDividers(){
+  // 아직 반영 전이면 적재된 값을 보고(CLI가 설정 직후 출력해도 일관)
+  Dividers d;
+  portENTER_CRITICAL(&g_stageMux);
+  d = (g_stageMask & ST_DIV) ? g_stage.div : g_div;
+  portEXIT_CRITICAL(&g_stageMux);
+  return d;
+}
+
+void setStickCurve(float deadzone, float gamma){
+  // LUT 생성(수 ms)은 호출 태스크에서 — 입력 tick은 완성된 포인터만 게시
+  const StickShaping::Lut* lut = Gamepad::buildCurve(deadzone, gamma);
+  portENTER_CRITICAL(&g_stageMux);
+  g_stage.lut = lut;
+  g_stageMask |= ST_CURVE;
+  portEXIT_CRITICAL(&g_stageMux);
+}
+
+void setStickAutoCal(bool en){
+  portENTER_CRITICAL(&g_stageMux);
+  g_stage.autoCal = en;
+  g_stageMask |= ST_AUTOCAL;
+  portEXIT_CRITICAL(&g_stageMux);
+}
+
+void setFilters(uint8_t joyMode, const OneEuro::Params& joy, uint8_t tpMode, const OneEuro::Params& tp){
+  portENTER_CRITICAL(&g_stageMux);
+  g_stage.joyMode = joyMode; g_stage.joy = joy;
+  g_stage.tpMode  = tpMode;  g_stage.tp  = tp;
+  g_stageMask |= ST_FILTERS;
+  portEXIT_CRITICAL(&g_stageMux);
+}
+
+void setPointerAccel(const PointerBallistics::Params& p){
+  portENTER_CRITICAL(&g_stageMux);
+  g_stage.acc = p;
+  g_stageMask |= ST_ACCEL;
+  portEXIT_CRITICAL(&g_stageMux);
+}
+
+void setDebounce(uint16_t pressMs, uint16_t releaseMs, bool eager){
+  portENTER_CRITICAL(&g_stageMux);
+  g_stage.pressMs   = pressMs;
+  g_stage.releaseMs = releaseMs;
+  g_stage.eager     = eager;
+  g_stageMask |= ST_DEB;
+  portEXIT_CRITICAL(&g_stageMux);
 }
 
 FactoryAction pollFactoryAction(){
@@ -2,15 +2,45 @@
 //
 // RuntimeInput — 오케스트라(입력 파이프라인/제스처 호출 순서만 담당)
 // - init(): 서브 파이프라인 초기화
-// - tick(now_ms): 매 프레임 호출
+// - tick(now_us): 입력 스케줄러(InputScheduler)가 고정 주기로 호출
+//   버튼은 tick당 1회 HAL::readButtonMask()로 샘플 → 디바운스 → HAL::InputFrame을 모든 파이프라인에 전달
+// - 파이프라인별 분주비: 스케줄러 주기 N회마다 1회 실행
 //
 
 #include <stdint.h>
+#include "OneEuroFilter.h"
+#include "PointerBallistics.h"
 
 namespace RuntimeInput {
 
 void init();
-void tick(uint32_t now_ms);
+void tick(uint64_t now_us);
+
+// 파이프라인별 분주비(1..255, 0은 1로 취급)
+struct Dividers {
+  uint8_t gesture  = 2;
+  uint8_t touchpad = 2;
+  uint8_t slider   = 2;
+  uint8_t gamepad  = 1;
+};
+void setDividers(const Dividers& d);
+Dividers getDividers();
+
+// 설정 반영(오케스트라 applyConfigToRuntime / CLI에서 호출)
+//  - 아래 setter는 어느 태스크에서 불러도 되며 값을 적재만 함. 실제 반영은 다음 tick 시작 시 입력 태스크에서
+//  - setStickCurve는 호출 태스크에서 LUT를 생성(수 ms)한 뒤 포인터만 적재 — 입력 태스크에서 부르지 말 것,
+//    곡선 설정은 한 태스크(CLI/loop)에서만
+void setStickCurve(float deadzone, float gamma);
+void setStickAutoCal(bool en);
+
+// 필터 단계(게임패드: EMA/1€, 터치패드: 없음/1€)
+void setFilters(uint8_t joyMode, const OneEuro::Params& joy, uint8_t tpMode, const OneEuro::Params& tp);
+
+// 터치 커서 가속 곡선
+void setPointerAccel(const PointerBallistics::Params& p);
+
+// 버튼 디바운스(ms). 스케줄러 주기 기준 틱으로 환산(주기가 바뀌면 자동 재환산)
+void setDebounce(uint16_t pressMs, uint16_t releaseMs, bool eager);
 
 // 팩토리 진입 이벤트를 메인으로 넘기고 싶다면(선택 API)
 // 내부 GestureEngine이 판단한 결과를 즉시 소비하지 않고 외부로 전달.
@@ -4,13 +4,17 @@
 #include "../haptics/HapticsRuntime.h"
 #include "../core/ConfigStore.h"
 #include "../core/Log.h"
+#include "SliderStage.h"
 
 namespace {
 
 struct State {
   int last = -1;
-  long acc = 0;           // 누적 Δ (모드별로 사용)
+  long acc = 0;           // 누적 Δ (줌: Δ 단위, 휠: Δ×16 단위 — 모드 전환 시 리셋)
+  long fineNotch = 0;     // 휠: 노치 경계 통과 판정용 1/16 노치 누적
   int  stepTick = 0;      // 4 스텝마다 작은 LRA
+  SliderStage::Stage stage;   // 적응형 처리(sl_adapt)
+  float carry = 0.0f;         // 적응형: 정수 Δ로 넘기고 남은 유효 Δ
   Slider::Mode mode = Slider::Mode::Wheel;
 
   // LED indicator 유지
@@ -41,23 +45,60 @@ void init(){
   S.mode = (ConfigStore::get().initial_mode == 1) ? Mode::Zoom : Mode::Wheel;
 }
 
+void getStageInfo(StageInfo& out){
+  out.adaptive = ConfigStore::get().sl_adapt;
+  out.floor    = S.stage.floorCnt;
+  out.velocity = S.stage.vel;
+  out.gain     = S.stage.gain;
+}
+
 Slider::Mode getMode(){ return S.mode; }
-void setMode(Slider::Mode m){ S.mode = m; }
+void setMode(Slider::Mode m){
+  if (m != S.mode){ S.acc = 0; S.fineNotch = 0; S.carry = 0.0f; }
+  S.mode = m;
+}
 
-void tick(uint32_t now_ms){
+void tick(const HAL::InputFrame& in, uint32_t now_ms){
   tickIndicator(now_ms);
 
   // 터치 중엔 억제(손가락이 패드에 있을 때 슬라이더 동작하지 않음)
-  if (HAL::pressed(HAL::Button::TouchDigital)) return;
+  if (in.down(HAL::Button::TouchDigital)) return;
 
+  const auto& cfg = ConfigStore::get();
   const int v = HAL::readSliderRaw();
-  if (S.last < 0) { S.last = v; return; }
-
-  const int dv = v - S.last;
-  const int th = ConfigStore::get().slider_thresh;
-  if (abs(dv) <= th) return;
-
-  S.last = v;
+  int dv = 0;
+
+  if (cfg.sl_adapt){
+    // 적응형: 중앙값 → 학습된 노이즈 바닥 → 속도 이득. 이득이 곧 스텝 크기를 바꿈(zstep/wstep = 이득 1 기준)
+    SliderStage::Params p;
+    p.vLo = (float)cfg.sl_v_lo;  p.vHi = (float)cfg.sl_v_hi;
+    p.gLo = cfg.sl_g_lo;         p.gHi = cfg.sl_g_hi;
+    p.floorMax = (float)cfg.slider_thresh;
+    const float x = S.stage.step(v, now_ms, p) + S.carry;
+    dv = (int)x;
+    S.carry = x - (float)dv;
+    S.last = -1;
+    if (dv == 0) return;
+  } else {
+    S.stage.reset(); S.carry = 0.0f;
+    if (S.last < 0) { S.last = v; return; }
+
+    dv = v - S.last;
+    const int th = cfg.slider_thresh;
+    if (abs(dv) <= th) return;
+
+    // 호스트 휠 배수(1/16 노치)가 켜져 있으면 임계를 게이트가 아닌 히스테리시스로:
+    // 기준점이 th만큼 뒤따라가며 넘은 양만 전달 → 임계 이후 작은 움직임도 1/16 노치 스텝으로 나감
+    const bool fineAxis = (S.mode == Mode::Wheel) &&
+        ((cfg.wheel_axis == ConfigStore::WHEEL_PAN) ? USBDevices::panMultiplier()
+                                                    : USBDevices::wheelMultiplier()) > 1;
+    if (fineAxis){
+      dv -= (dv > 0) ? th : -th;
+      S.last += dv;
+    } else {
+      S.last = v;
+    }
+  }
 
   // 공통: 4스텝마다 촉각
   auto tickHaptics = [&](){
@@ -70,7 +111,7 @@ void tick(uint32_t now_ms){
 
   if (S.mode == Mode::Zoom){
     S.acc += dv;
-    const int step = ConfigStore::get().zoom_step_dv;
+    const int step = cfg.zoom_step_dv;
     int localTicks = 0;
 
     while (S.acc >= step){ USBDevices::keyZoomIn();  S.acc -= step; localTicks++; }
@@ -83,12 +124,22 @@ void tick(uint32_t now_ms){
       S.indicatorUntil = now_ms + 250; // 유지 연장
     }
   } else {
-    S.acc += dv;
-    const int step = ConfigStore::get().wheel_step_dv;
+    // 고해상도 휠: wheel_step_dv = 1노치, Δ를 1/16 노치 단위로 환산해 tick당 1회 전달
+    // (스텝 미만 나머지는 acc에 이월 — 호스트 배수가 꺼져 있으면 USBDev가 노치로 모음)
+    constexpr int FINE = USBDevices::WHEEL_FINE_PER_NOTCH;
+    S.acc += (long)dv * FINE;
+    const int step = cfg.wheel_step_dv;
+    const long fine = S.acc / step;
+    S.acc -= fine * step;
     int localTicks = 0;
 
-    while (S.acc >= step){ USBDevices::mouseWheel(+1); S.acc -= step; localTicks++; }
-    while (S.acc <= -step){USBDevices::mouseWheel(-1); S.acc += step; localTicks++; }
+    if (fine){
+      if (cfg.wheel_axis == ConfigStore::WHEEL_PAN) USBDevices::mousePanFine((int)fine);
+      else                                                         USBDevices::mouseWheelFine((int)fine);
+      S.fineNotch += fine;
+      while (S.fineNotch >= FINE){ S.fineNotch -= FINE; localTicks++; }
+      while (S.fineNotch <= -FINE){S.fineNotch += FINE; localTicks++; }
+    }
 
     if (localTicks>0){
       tickHaptics();
@@ -4,15 +4,25 @@
 //
 
 #include <stdint.h>
+#include "../hal/HAL.h"
 
 namespace Slider {
 
 void init();
-void tick(uint32_t now_ms);
+void tick(const HAL::InputFrame& in, uint32_t now_ms);
 
 // 외부에서 모드를 읽고 싶을 때(보통은 Gesture가 내부적으로 관리)
 enum class Mode : uint8_t { Wheel=0, Zoom=1 };
 Mode getMode();
 void setMode(Mode m); // Gesture가 토글 시 호출
 
+// 적응형 처리 단계 상태(sl_adapt) — CLI 조회용
+struct StageInfo {
+  bool  adaptive = false;
+  float floor    = 0.0f;   // 학습된 노이즈 바닥(카운트)
+  float velocity = 0.0f;   // 필터된 속도(카운트/s)
+  float gain     = 1.0f;   // 마지막 속도 이득
+};
+void getStageInfo(StageInfo& out);
+
 } // namespace Slider
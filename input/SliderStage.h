@@ -0,0 +1,123 @@
+#pragma once
+//
+// SliderStage.h — 슬라이더 속도 적응형 처리 단계
+//  - 판독: 최근 MEDIAN_N 샘플 중앙값(ADC Continuous 모드면 HAL에서 이미 채널당 오버샘플/축약된 값)
+//  - 노이즈 바닥: 히스테리시스(백래시) 추종 — 출력 위치는 |중앙값-위치| > floor 일 때만 초과분만큼 이동
+//      · 정지 REST_MS 이상이면 평균 절대편차(MAD)로 floor 학습: FLOOR_K·MAD + 1
+//      · REVERSAL_MS 안의 방향 반전(정지 중 지터)은 floor를 1씩 올림
+//      · 상한은 slider_thresh(고정 데드밴드 대체), 하한 FLOOR_MIN
+//  - 속도 이득: 필터된 속도(카운트/s)가 vLo→vHi 구간에서 gLo→gHi로 smoothstep 보간
+//      · 느린 이동: gLo < 1 → 같은 이동에 스텝이 덜 나와 정밀
+//      · 빠른 이동: gHi > 1 → 짧은 스와이프로 넓은 범위
+//  - 출력: 이번 샘플의 유효 Δ(카운트 × 이득, 부호 포함). 스텝 환산/나머지 이월은 파이프라인 몫
+//  - Arduino 의존성 없음(float 연산만)
+//
+
+#include <stdint.h>
+#include "OneEuroFilter.h"
+
+namespace SliderStage {
+
+inline constexpr uint8_t  MEDIAN_N     = 5;
+inline constexpr uint32_t REST_MS      = 400;    // 이만큼 움직임이 없으면 노이즈 학습
+inline constexpr uint32_t REVERSAL_MS  = 60;     // 이보다 빠른 방향 반전은 노이즈로 간주
+inline constexpr float    FLOOR_K      = 3.0f;
+inline constexpr float    FLOOR_MIN    = 2.0f;
+inline constexpr float    NOISE_ALPHA  = 1.0f / 16.0f;
+inline constexpr float    VEL_CUTOFF_HZ = 8.0f;  // 속도 저역통과
+
+struct Params {
+  float vLo = 200.0f;     // 카운트/s — 이하면 gLo
+  float vHi = 2500.0f;    // 카운트/s — 이상이면 gHi
+  float gLo = 0.5f;
+  float gHi = 3.0f;
+  float floorMax = 25.0f; // = slider_thresh
+};
+
+inline uint16_t median(const uint16_t* w, uint8_t n){
+  uint16_t a[MEDIAN_N];
+  for (uint8_t i = 0; i < n; ++i){
+    uint16_t v = w[i];
+    uint8_t j = i;
+    for (; j > 0 && a[j - 1] > v; --j) a[j] = a[j - 1];
+    a[j] = v;
+  }
+  return a[n / 2];
+}
+
+inline float gainFor(float vel, const Params& p){
+  if (!(p.vHi > p.vLo)) return (vel >= p.vHi) ? p.gHi : p.gLo;
+  float t = (vel - p.vLo) / (p.vHi - p.vLo);
+  t = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+  t = t * t * (3.0f - 2.0f * t);
+  return p.gLo + (p.gHi - p.gLo) * t;
+}
+
+struct Stage {
+  uint16_t win[MEDIAN_N] = {0};
+  uint8_t  n = 0, head = 0;
+
+  float    pos = 0.0f;       // 백래시 출력(카운트)
+  float    vel = 0.0f;       // 필터된 |속도| (카운트/s)
+  float    gain = 1.0f;      // 마지막 이득
+  float    mean = 0.0f;      // 정지 중 중앙값 평균
+  float    mad = 0.0f;       // 정지 중 평균 절대편차
+  float    floorCnt = 0.0f;     // 현재 노이즈 바닥(카운트)
+  uint32_t lastMs = 0, lastMoveMs = 0;
+  int8_t   lastDir = 0;
+  bool     primed = false;
+
+  void reset(){ *this = Stage{}; }
+
+  // raw: 0..4095, 반환: 유효 Δ(카운트 × 이득)
+  float step(int raw, uint32_t now_ms, const Params& p){
+    win[head] = (uint16_t)raw;
+    head = (uint8_t)((head + 1) % MEDIAN_N);
+    if (n < MEDIAN_N) ++n;
+    const float m = (float)median(win, n);
+
+    if (!primed){
+      pos = mean = m; vel = 0.0f; floorCnt = p.floorMax;
+      mad = (p.floorMax - 1.0f) / FLOOR_K;   // 보수적으로 시작해 아래로 수렴
+      lastMs = lastMoveMs = now_ms; lastDir = 0; primed = true;
+      return 0.0f;
+    }
+    if (floorCnt > p.floorMax) floorCnt = p.floorMax;
+    if (floorCnt < FLOOR_MIN)  floorCnt = FLOOR_MIN;
+
+    const uint32_t dtMs = (now_ms - lastMs) ? (now_ms - lastMs) : 1;
+    lastMs = now_ms;
+
+    float d = 0.0f;
+    if      (m > pos + floorCnt) d = m - floorCnt - pos;
+    else if (m < pos - floorCnt) d = m + floorCnt - pos;
+    pos += d;
+
+    const float dtS = (float)dtMs * 0.001f;
+    const float inst = ((d < 0.0f) ? -d : d) / dtS;
+    vel += OneEuro::alpha(VEL_CUTOFF_HZ, dtS) * (inst - vel);
+
+    if (d != 0.0f){
+      const int8_t dir = (d > 0.0f) ? 1 : -1;
+      if (lastDir && dir != lastDir && now_ms - lastMoveMs < REVERSAL_MS && floorCnt + 1.0f <= p.floorMax) floorCnt += 1.0f;
+      lastDir = dir;
+      lastMoveMs = now_ms;
+      mean = m;
+    } else {
+      mean += NOISE_ALPHA * (m - mean);
+      if (now_ms - lastMoveMs >= REST_MS){
+        const float e = m - mean;
+        mad += NOISE_ALPHA * (((e < 0.0f) ? -e : e) - mad);
+        float f = FLOOR_K * mad + 1.0f;
+        f = (f < FLOOR_MIN) ? FLOOR_MIN : (f > p.floorMax) ? p.floorMax : f;
+        floorCnt = (f > floorCnt) ? f : floorCnt + NOISE_ALPHA * (f - floorCnt);   // 올림은 즉시, 내림은 천천히
+        lastDir = 0;
+      }
+    }
+
+    gain = gainFor(vel, p);
+    return d * gain;
+  }
+};
+
+} // namespace SliderStage
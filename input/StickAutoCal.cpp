@@ -0,0 +1,198 @@
+#include "StickAutoCal.h"
+#include "../core/Log.h"
+
+namespace {
+
+using ConfigStore::StickCal;
+
+constexpr uint8_t  EXT_CONFIRM     = 8;      // 범위 밖 연속 샘플 수(확장 확정)
+constexpr uint16_t EXT_SPREAD      = 64;     // 연속 구간 내 허용 편차(넘으면 구간 재시작 — 노이즈/스파이크 거부)
+constexpr uint16_t RAIL_MARGIN     = 4;      // 0/4095 레일 부근은 확장에서 제외
+constexpr uint16_t MIN_HALF_SPAN   = 600;    // center 기준 최소 반폭(축이 퇴화하지 않도록)
+
+constexpr uint16_t IDLE_BAND       = 120;    // |raw-center| 이내면 정지 후보
+constexpr uint32_t IDLE_MS         = 1500;   // 이만큼 유지되면 센터 추적 시작
+constexpr uint8_t  CENTER_SHIFT    = 6;      // 센터 EMA α = 1/64 (Q8 누산)
+constexpr uint16_t CENTER_MAX_STEP = 200;    // 저장된 센터에서 벗어날 수 있는 최대 폭
+
+// 재계산/스테이징 임계(카운트)
+constexpr uint16_t APPLY_DELTA     = 2;
+constexpr uint16_t STAGE_DELTA     = 6;
+
+// 범위 밖 연속 구간: 샘플 수 + 구간 내 최소/최대
+struct Run {
+  uint8_t  n = 0;
+  uint16_t lo = 0, hi = 0;
+
+  // v 추가. 구간 편차가 EXT_SPREAD를 넘으면 v부터 재시작
+  void add(uint16_t v){
+    if (n == 0 || (v > lo ? v - lo : 0) > EXT_SPREAD || (hi > v ? hi - v : 0) > EXT_SPREAD){
+      n = 0; lo = hi = v;
+    }
+    if (v < lo) lo = v;
+    if (v > hi) hi = v;
+    ++n;
+  }
+};
+
+struct AxisTrack {
+  Run      hiRun, loRun;
+  uint32_t cenQ8 = 0;                     // 센터 EMA(Q8)
+};
+
+StickCal  s_cal;           // 현재 적용값
+StickCal  s_applied;       // 마지막으로 update()가 true를 돌려준 시점 값
+StickCal  s_staged;        // 마지막 스테이징 값
+AxisTrack s_trk[StickAutoCal::AXES];
+uint16_t  s_cenAnchor[StickAutoCal::AXES];   // 드리프트 한계 기준
+bool      s_enabled = true;
+uint32_t  s_idleSince[2] = {0, 0};           // 스틱(L/R)별 정지 시작
+bool      s_idle[2] = {false, false};
+
+StickCal makeDefaults(){
+  StickCal c;
+  c.ver  = ConfigStore::STICKCAL_VER;
+  c.axes = StickAutoCal::AXES;
+  for (uint8_t i = 0; i < StickAutoCal::AXES; ++i){
+    c.cenV[i] = StickAutoCal::DEFAULT_CENTER;
+    c.minV[i] = StickAutoCal::DEFAULT_CENTER - StickAutoCal::DEFAULT_HALF_SPAN;
+    c.maxV[i] = StickAutoCal::DEFAULT_CENTER + StickAutoCal::DEFAULT_HALF_SPAN;
+  }
+  return c;
+}
+
+inline uint16_t absDiff(uint16_t a, uint16_t b){ return (a > b) ? (a - b) : (b - a); }
+
+uint16_t maxDelta(const StickCal& a, const StickCal& b){
+  uint16_t m = 0;
+  for (uint8_t i = 0; i < StickAutoCal::AXES; ++i){
+    const uint16_t d0 = absDiff(a.minV[i], b.minV[i]);
+    const uint16_t d1 = absDiff(a.cenV[i], b.cenV[i]);
+    const uint16_t d2 = absDiff(a.maxV[i], b.maxV[i]);
+    if (d0 > m) m = d0;
+    if (d1 > m) m = d1;
+    if (d2 > m) m = d2;
+  }
+  return m;
+}
+
+void resetTracks(){
+  for (uint8_t i = 0; i < StickAutoCal::AXES; ++i){
+    s_trk[i] = AxisTrack{};
+    s_trk[i].cenQ8 = (uint32_t)s_cal.cenV[i] << 8;
+    s_cenAnchor[i] = s_cal.cenV[i];
+  }
+  s_idle[0] = s_idle[1] = false;
+}
+
+// 범위 유지: min < center-MIN_HALF_SPAN, max > center+MIN_HALF_SPAN
+void keepSpan(uint8_t i){
+  if (s_cal.cenV[i] < MIN_HALF_SPAN) s_cal.cenV[i] = MIN_HALF_SPAN;
+  if (s_cal.cenV[i] > 4095 - MIN_HALF_SPAN) s_cal.cenV[i] = 4095 - MIN_HALF_SPAN;
+  if (s_cal.minV[i] + MIN_HALF_SPAN > s_cal.cenV[i]) s_cal.minV[i] = s_cal.cenV[i] - MIN_HALF_SPAN;
+  if (s_cal.maxV[i] < s_cal.cenV[i] + MIN_HALF_SPAN) s_cal.maxV[i] = s_cal.cenV[i] + MIN_HALF_SPAN;
+}
+
+void trackExtremes(uint8_t i, uint16_t v){
+  AxisTrack& t = s_trk[i];
+
+  // 상한 확장 후보 → 확정 시 구간 최소값(보수적)으로 확장
+  if (v > s_cal.maxV[i] && v < 4095 - RAIL_MARGIN){
+    t.hiRun.add(v);
+    if (t.hiRun.n >= EXT_CONFIRM){ s_cal.maxV[i] = t.hiRun.lo; t.hiRun.n = 0; }
+  } else {
+    t.hiRun.n = 0;
+  }
+
+  // 하한 확장 후보 → 확정 시 구간 최대값(보수적)으로 확장
+  if (v < s_cal.minV[i] && v > RAIL_MARGIN){
+    t.loRun.add(v);
+    if (t.loRun.n >= EXT_CONFIRM){ s_cal.minV[i] = t.loRun.hi; t.loRun.n = 0; }
+  } else {
+    t.loRun.n = 0;
+  }
+}
+
+void trackCenter(uint8_t stick, const uint16_t v[2], uint32_t now_ms){
+  const uint8_t ax = stick * 2;
+  const bool near = absDiff(v[0], s_cal.cenV[ax]) <= IDLE_BAND && absDiff(v[1], s_cal.cenV[ax + 1]) <= IDLE_BAND;
+  if (!near){ s_idle[stick] = false; return; }
+  if (!s_idle[stick]){ s_idle[stick] = true; s_idleSince[stick] = now_ms; return; }
+  if (now_ms - s_idleSince[stick] < IDLE_MS) return;
+
+  for (uint8_t k = 0; k < 2; ++k){
+    AxisTrack& t = s_trk[ax + k];
+    const int32_t target = (int32_t)v[k] << 8;
+    t.cenQ8 = (uint32_t)((int32_t)t.cenQ8 + ((target - (int32_t)t.cenQ8) >> CENTER_SHIFT));
+    uint16_t c = (uint16_t)((t.cenQ8 + 128) >> 8);
+    const uint16_t a = s_cenAnchor[ax + k];
+    if (c > a + CENTER_MAX_STEP) c = a + CENTER_MAX_STEP;
+    if (c + CENTER_MAX_STEP < a) c = a - CENTER_MAX_STEP;
+    s_cal.cenV[ax + k] = c;
+    keepSpan(ax + k);
+  }
+}
+
+} // anon
+
+namespace StickAutoCal {
+
+void init(){
+  StickCal c;
+  if (ConfigStore::loadStickCal(c)){
+    s_cal = c;
+    LOGI("GP", "stick cal loaded");
+  } else {
+    s_cal = makeDefaults();
+  }
+  for (uint8_t i = 0; i < AXES; ++i) keepSpan(i);
+  s_applied = s_cal;
+  s_staged  = s_cal;
+  resetTracks();
+}
+
+bool update(const HAL::SticksRaw& r, uint32_t now_ms){
+  if (!s_enabled) return false;
+
+  const uint16_t v[AXES] = { (uint16_t)r.lx, (uint16_t)r.ly, (uint16_t)r.rx, (uint16_t)r.ry };
+  for (uint8_t i = 0; i < AXES; ++i) trackExtremes(i, v[i]);
+  trackCenter(0, &v[LX], now_ms);
+  trackCenter(1, &v[RX], now_ms);
+
+  if (maxDelta(s_cal, s_staged) >= STAGE_DELTA){
+    s_staged = s_cal;
+    ConfigStore::stageStickCal(s_cal);
+  }
+  if (maxDelta(s_cal, s_applied) >= APPLY_DELTA){
+    s_applied = s_cal;
+    return true;
+  }
+  return false;
+}
+
+const ConfigStore::StickCal& current(){ return s_applied; }
+
+void setCenters(int lx, int ly, int rx, int ry){
+  const int c[AXES] = { lx, ly, rx, ry };
+  for (uint8_t i = 0; i < AXES; ++i){
+    s_cal.cenV[i] = (uint16_t)((c[i] < 0) ? 0 : (c[i] > 4095) ? 4095 : c[i]);
+    keepSpan(i);
+  }
+  resetTracks();
+  s_applied = s_cal;
+  s_staged  = s_cal;
+  ConfigStore::stageStickCal(s_cal);
+}
+
+void setEnabled(bool en){ s_enabled = en; }
+bool enabled(){ return s_enabled; }
+
+void reset(){
+  s_cal = makeDefaults();
+  resetTracks();
+  s_applied = s_cal;
+  s_staged  = s_cal;
+  ConfigStore::stageStickCal(s_cal);
+}
+
+} // namespace StickAutoCal
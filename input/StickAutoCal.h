@@ -0,0 +1,42 @@
+#pragma once
+//
+// StickAutoCal — 스틱 min/max/center 온라인 자동 보정
+//  - 극값: 현재 범위를 벗어난 값이 좁은 편차로 EXT_CONFIRM 샘플 연속일 때만 확장(스파이크/글리치 거부)
+//          확장 폭은 그 연속 구간의 가장 보수적인 값(최대는 최소값, 최소는 최대값)
+//  - 센터: 스틱이 IDLE_MS 이상 센터 근처에 머무르면 느린 EMA로 드리프트 추적
+//  - 의미 있는 변화가 생기면 ConfigStore::stageStickCal()로 스테이징(실제 NVS 쓰기는 코얼레싱)
+//  - 축 순서/값은 HAL::SticksRaw(raw LX, LY, RX, RY) 기준
+//
+
+#include <stdint.h>
+#include "../hal/HAL.h"
+#include "../core/ConfigStore.h"
+
+namespace StickAutoCal {
+
+enum Axis : uint8_t { LX = 0, LY, RX, RY, AXES };
+
+// 초기값(저장된 보정이 없을 때) — 좁게 시작해서 실제 풀 스로우까지 넓혀 감
+inline constexpr uint16_t DEFAULT_CENTER    = 2048;
+inline constexpr uint16_t DEFAULT_HALF_SPAN = 1300;
+
+// 시작: 저장된 blob이 있으면 사용, 없으면 기본값
+void init();
+
+// 입력 tick마다 호출. 정규화 계수를 다시 계산해야 할 변화가 있으면 true
+bool update(const HAL::SticksRaw& r, uint32_t now_ms);
+
+// 현재 보정값
+const ConfigStore::StickCal& current();
+
+// 수동 재보정 결과 반영(센터만 교체, 범위 유지) + 스테이징
+void setCenters(int lx, int ly, int rx, int ry);
+
+// 자동 추적 on/off (off여도 저장된 값/수동 센터는 유지)
+void setEnabled(bool en);
+bool enabled();
+
+// 기본값으로 초기화 + 스테이징
+void reset();
+
+} // namespace StickAutoCal
@@ -0,0 +1,271 @@
+#pragma once
+//
+// StickShaping.h — 스틱 정규화/데드존/감마/원형클램프 커널 (Q15 고정소수점)
+//  - 반경 데드존 · 감마 곡선 · 원형 클램프는 LUT + 선형보간으로 처리
+//  - 기본 곡선 LUT는 컴파일 타임(constexpr) 생성, 곡선 설정이 바뀌면 런타임에 같은 함수로 재생성
+//  - Arduino 의존성 없음(호스트 벤치/검증에서 그대로 include 가능)
+//  - Ref:: 는 기존 float 구현(비교 기준). 펌웨어 경로는 고정소수점만 사용
+//
+
+#include <stdint.h>
+#include <math.h>
+
+namespace StickShaping {
+
+// Q15: ±1.0 ↔ ±32767 (int32 컨테이너)
+inline constexpr int32_t Q15_ONE = 1 << 15;
+inline constexpr int32_t Q15_MAX = Q15_ONE - 1;
+
+// ========= constexpr 수학(LUT 생성 전용, double) =========
+namespace cx {
+
+constexpr double sqrt(double x){
+  if (x <= 0.0) return 0.0;
+  double g = (x > 1.0) ? x : 1.0;
+  for (int i = 0; i < 64; ++i){
+    const double n = 0.5 * (g + x / g);
+    if (n == g) break;
+    g = n;
+  }
+  return g;
+}
+
+constexpr double ln(double x){
+  // x = m·2^e, m∈[1,2) → ln(m) = 2·atanh((m-1)/(m+1))
+  constexpr double LN2 = 0.69314718055994530942;
+  int e = 0;
+  while (x >= 2.0){ x *= 0.5; ++e; }
+  while (x <  1.0){ x *= 2.0; --e; }
+  const double z  = (x - 1.0) / (x + 1.0);
+  const double z2 = z * z;
+  double term = z, sum = 0.0;
+  for (int k = 0; k < 40; ++k){
+    sum  += term / (2 * k + 1);
+    term *= z2;
+  }
+  return 2.0 * sum + e * LN2;
+}
+
+constexpr double exp(double x){
+  // x = k·ln2 + r, |r| ≤ ln2/2
+  constexpr double LN2 = 0.69314718055994530942;
+  int k = 0;
+  while (x >  0.5 * LN2){ x -= LN2; ++k; }
+  while (x < -0.5 * LN2){ x += LN2; --k; }
+  double term = 1.0, sum = 1.0;
+  for (int i = 1; i < 30; ++i){
+    term *= x / i;
+    sum  += term;
+  }
+  while (k > 0){ sum *= 2.0; --k; }
+  while (k < 0){ sum *= 0.5; ++k; }
+  return sum;
+}
+
+constexpr double pow(double a, double g){
+  return (a <= 0.0) ? 0.0 : exp(g * ln(a));
+}
+
+constexpr int32_t roundQ15(double v){
+  return (int32_t)(v * Q15_ONE + 0.5);
+}
+
+} // namespace cx
+
+// ========= LUT =========
+// radial : q=r² ∈ [dz², 2] 구간을 등간격 분할, 값 k(q) = s(√q)/√q (Q15, ≤1)
+// curve  : |v| ∈ [0, 1]  → |v|^γ (Q15)
+// invsqrt: q   ∈ [1, 2]  → 1/√q   (Q15)
+inline constexpr int RADIAL_SEG = 256;
+inline constexpr int CURVE_SEG  = 256;
+inline constexpr int INVSQ_SEG  = 64;
+
+struct Lut {
+  uint16_t radial[RADIAL_SEG + 1];
+  uint16_t curve[CURVE_SEG + 1];
+  uint16_t invsqrt[INVSQ_SEG + 1];
+
+  uint32_t dz2Q30;      // 데드존 반경² (Q30)
+  uint32_t radialMul;   // (r² - dz²) → 세그먼트 위치(Q16) 변환 배수 (>>32)
+};
+
+constexpr Lut makeLut(double deadzone, double gamma){
+  Lut t{};
+  if (deadzone < 0.0)  deadzone = 0.0;
+  if (deadzone > 0.95) deadzone = 0.95;
+  if (gamma < 0.1)     gamma = 0.1;
+
+  const double dz2  = deadzone * deadzone;
+  const double span = 2.0 - dz2;
+
+  for (int i = 0; i <= RADIAL_SEG; ++i){
+    const double q = dz2 + span * i / RADIAL_SEG;
+    const double r = cx::sqrt(q);
+    double s = (r - deadzone) / (1.0 - deadzone);
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    const double k = (r > 0.0) ? (s / r) : 0.0;
+    t.radial[i] = (uint16_t)cx::roundQ15(k);
+  }
+  for (int i = 0; i <= CURVE_SEG; ++i){
+    t.curve[i] = (uint16_t)cx::roundQ15(cx::pow((double)i / CURVE_SEG, gamma));
+  }
+  for (int i = 0; i <= INVSQ_SEG; ++i){
+    t.invsqrt[i] = (uint16_t)cx::roundQ15(1.0 / cx::sqrt(1.0 + (double)i / INVSQ_SEG));
+  }
+
+  const double one30 = 1073741824.0;          // 2^30
+  t.dz2Q30    = (uint32_t)(dz2 * one30 + 0.5);
+  // pos(Q16) = (r²-dz²)·RADIAL_SEG·2^16 / (span·2^30) = (Δ · radialMul) >> 32
+  t.radialMul = (uint32_t)((double)RADIAL_SEG * 65536.0 * 4294967296.0 / (span * one30) );
+  return t;
+}
+
+// 기본 곡선(기존 JOY_DEADZONE=0.15, JOY_GAMMA=1.4) — 플래시 상주
+inline constexpr double DEFAULT_DEADZONE = 0.15;
+inline constexpr double DEFAULT_GAMMA    = 1.4;
+inline constexpr Lut kDefaultLut = makeLut(DEFAULT_DEADZONE, DEFAULT_GAMMA);
+
+// ========= 축 정규화 =========
+// 축마다 min/center/max가 바뀔 때만 recip을 다시 계산
+struct AxisNorm {
+  int32_t minV = 0, cenV = 2048, maxV = 4095;
+  int32_t recip    = 0;   // center 위쪽 스케일: 2^24 / (max-min)  (분할 모드: 2^23 / (max-center))
+  int32_t recipNeg = 0;   // center 아래쪽 스케일(대칭 모드에서는 recip과 동일)
+};
+
+// 대칭: 양쪽 모두 (max-min)/2 기준 (기존 float 구현과 동일)
+inline void axisPrepare(AxisNorm& a, int minV, int cenV, int maxV){
+  a.minV = minV; a.cenV = cenV; a.maxV = maxV;
+  const int32_t span = (maxV > minV) ? (maxV - minV) : 1;
+  a.recip = ((1 << 24) + span / 2) / span;
+  a.recipNeg = a.recip;
+}
+
+// 분할: center~max, min~center를 각각 ±1로 매핑(자동 보정된 비대칭 축용)
+inline void axisPrepareSplit(AxisNorm& a, int minV, int cenV, int maxV){
+  a.minV = minV; a.cenV = cenV; a.maxV = maxV;
+  int32_t hi = maxV - cenV, lo = cenV - minV;
+  if (hi < 64) hi = 64;
+  if (lo < 64) lo = 64;
+  a.recip    = ((1 << 23) + hi / 2) / hi;
+  a.recipNeg = ((1 << 23) + lo / 2) / lo;
+}
+
+// raw(0..4095) → Q15 (-1..+1). (raw-center)/halfSpan 과 동일
+inline int32_t normalizeQ15(int raw, const AxisNorm& a){
+  if (raw < a.minV) raw = a.minV;
+  if (raw > a.maxV) raw = a.maxV;
+  const int32_t d = raw - a.cenV;
+  int32_t v = (d * ((d < 0) ? a.recipNeg : a.recip) + 128) >> 8;
+  if (v >  Q15_MAX) v =  Q15_MAX;
+  if (v < -Q15_MAX) v = -Q15_MAX;
+  return v;
+}
+
+// ========= EMA =========
+inline void emaQ15(int32_t alphaQ15, int32_t in, int32_t& s){
+  s += ((in - s) * alphaQ15) >> 15;
+}
+
+// ========= 내부: 보간 =========
+inline int32_t lerpU16(const uint16_t* tab, uint32_t idx, uint32_t frac, int fracBits){
+  const int32_t a = tab[idx];
+  const int32_t b = tab[idx + 1];
+  return a + (((b - a) * (int32_t)frac) >> fracBits);
+}
+
+inline int32_t curveQ15(int32_t v, const Lut& t){
+  const int32_t a = (v < 0) ? -v : v;              // 0..32767
+  const int32_t o = lerpU16(t.curve, (uint32_t)a >> 7, (uint32_t)a & 0x7F, 7);
+  return (v < 0) ? -o : o;
+}
+
+// ========= 반경 데드존 + 감마 + 원형 클램프 =========
+// x,y: Q15 (-1..+1), in/out
+inline void shapeQ15(int32_t& x, int32_t& y, const Lut& t){
+  const uint32_t r2 = (uint32_t)(x * x) + (uint32_t)(y * y);   // Q30, < 2^31
+  if (r2 < t.dz2Q30){ x = 0; y = 0; return; }
+
+  // 반경 스케일 k(r²)
+  const uint32_t pos  = (uint32_t)(((uint64_t)(r2 - t.dz2Q30) * t.radialMul) >> 32); // Q16
+  uint32_t idx = pos >> 16;
+  uint32_t frac = pos & 0xFFFF;
+  if (idx >= (uint32_t)RADIAL_SEG){ idx = RADIAL_SEG - 1; frac = 0xFFFF; }
+  const int32_t k = lerpU16(t.radial, idx, frac, 16);
+  x = (x * k) >> 15;
+  y = (y * k) >> 15;
+
+  // 축별 감마
+  x = curveQ15(x, t);
+  y = curveQ15(y, t);
+
+  // 원형 클램프(|v|>1 → 단위원으로)
+  const uint32_t rr2 = (uint32_t)(x * x) + (uint32_t)(y * y);
+  if (rr2 > (1u << 30)){
+    const uint32_t d = rr2 - (1u << 30);               // 0..2^30
+    uint32_t i2 = d >> 24;
+    uint32_t f2 = (d >> 8) & 0xFFFF;
+    if (i2 >= (uint32_t)INVSQ_SEG){ i2 = INVSQ_SEG - 1; f2 = 0xFFFF; }
+    const int32_t s = lerpU16(t.invsqrt, i2, f2, 16);
+    x = (x * s) >> 15;
+    y = (y * s) >> 15;
+  }
+}
+
+// Q15 → int8 (lroundf(v·127)과 동일한 반올림)
+inline int8_t q15ToI8(int32_t v){
+  if (v >  Q15_ONE) v =  Q15_ONE;
+  if (v < -Q15_ONE) v = -Q15_ONE;
+  return (v >= 0) ? (int8_t)((v * 127 + (1 << 14)) >> 15)
+                  : (int8_t)-(((-v) * 127 + (1 << 14)) >> 15);
+}
+
+// Q15 → int16 리포트 값(±32767로 클램프)
+inline int16_t q15ToI16(int32_t v){
+  if (v >  Q15_MAX) v =  Q15_MAX;
+  if (v < -Q15_MAX) v = -Q15_MAX;
+  return (int16_t)v;
+}
+
+// ========= 기존 float 구현(비교 기준, 펌웨어 경로에서는 미사용) =========
+namespace Ref {
+
+inline float normalizeAxis(int raw, int minV, int cenV, int maxV){
+  if (raw < minV) raw = minV;
+  if (raw > maxV) raw = maxV;
+  float halfSpan = (float)(maxV - minV) * 0.5f;
+  float mid      = (float)cenV;
+  float val      = ((float)raw - mid) / halfSpan;   // -1..+1
+  if (val >  1.f) val =  1.f;
+  if (val < -1.f) val = -1.f;
+  return val;
+}
+
+inline void shapeStick(float& x, float& y, float deadzone, float gamma){
+  float r = sqrtf(x*x + y*y);
+  if (r < deadzone){ x=0.f; y=0.f; return; }
+  float s = (r - deadzone) / (1.f - deadzone);
+  if (s < 0.f) s = 0.f;
+  if (s > 1.f) s = 1.f;
+  float k = (r > 0.f) ? (s / r) : 0.f;
+  x *= k; y *= k;
+  auto curve = [gamma](float v){
+    float a = fabsf(v);
+    float o = powf(a, gamma);
+    return (v >= 0.f) ? o : -o;
+  };
+  x = curve(x); y = curve(y);
+  const float rr = sqrtf(x*x + y*y);
+  if (rr > 1.f){ x/=rr; y/=rr; }
+}
+
+inline int8_t toI8(float v){
+  if (v >  1.f) v =  1.f;
+  if (v < -1.f) v = -1.f;
+  return (int8_t)lroundf(v * 127.0f);
+}
+
+} // namespace Ref
+
+} // namespace StickShaping
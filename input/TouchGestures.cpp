@@ -0,0 +1,193 @@
+#include "TouchGestures.h"
+#include "TouchPosition.h"
+
+#include "../usb/USBDevices.h"
+#include "../haptics/HapticsRuntime.h"
+
+namespace {
+
+using TouchGesture::State;
+using TouchGesture::Timing;
+using TouchGesture::ScrollAxis;
+
+enum class Ev : uint8_t { Down, EdgeDown, UpTap, Up, Move, TapExpire, Hold1, Hold2, Timeout };
+
+enum class Act : uint8_t { None, Click, ClickRight, PressL, ReleaseL, Arm, Disarm };
+
+// 전이 조건(Timing 기준)
+enum class Gd : uint8_t { Any, TapClick, TapDouble, Drag, DragTap, Lock, HoldOn };
+
+struct Tr { State from; Ev ev; Gd gd; State to; Act act; };
+
+// 위에서부터 첫 일치 행 적용 — 일치 행이 없으면 상태 유지
+constexpr Tr kTable[] = {
+  { State::Idle,      Ev::EdgeDown,  Gd::Any,       State::Scroll,    Act::None     },
+  { State::Idle,      Ev::Down,      Gd::Any,       State::Touch,     Act::None     },
+
+  { State::Touch,     Ev::Move,      Gd::Any,       State::Pointer,   Act::None     },
+  { State::Touch,     Ev::Hold1,     Gd::HoldOn,    State::Hold,      Act::Arm      },
+  { State::Touch,     Ev::UpTap,     Gd::TapDouble, State::TapGap,    Act::None     },
+  { State::Touch,     Ev::UpTap,     Gd::DragTap,   State::TapGap,    Act::Click    },
+  { State::Touch,     Ev::UpTap,     Gd::TapClick,  State::Idle,      Act::Click    },
+  { State::Touch,     Ev::UpTap,     Gd::Drag,      State::TapGap,    Act::None     },
+  { State::Touch,     Ev::UpTap,     Gd::Any,       State::Idle,      Act::None     },
+  { State::Touch,     Ev::Up,        Gd::Any,       State::Idle,      Act::None     },
+
+  { State::Pointer,   Ev::UpTap,     Gd::Any,       State::Idle,      Act::None     },
+  { State::Pointer,   Ev::Up,        Gd::Any,       State::Idle,      Act::None     },
+
+  { State::Hold,      Ev::Up,        Gd::Any,       State::Idle,      Act::ClickRight },
+  { State::Hold,      Ev::UpTap,     Gd::Any,       State::Idle,      Act::ClickRight },
+  { State::Hold,      Ev::Move,      Gd::Any,       State::Pointer,   Act::None     },
+  { State::Hold,      Ev::Hold2,     Gd::Any,       State::HoldOff,   Act::Disarm   },
+  { State::HoldOff,   Ev::Move,      Gd::Any,       State::Pointer,   Act::None     },
+  { State::HoldOff,   Ev::Up,        Gd::Any,       State::Idle,      Act::None     },
+  { State::HoldOff,   Ev::UpTap,     Gd::Any,       State::Idle,      Act::None     },
+
+  { State::TapGap,    Ev::Down,      Gd::Any,       State::TapTouch,  Act::None     },
+  { State::TapGap,    Ev::EdgeDown,  Gd::Any,       State::TapTouch,  Act::None     },
+  { State::TapGap,    Ev::Timeout,   Gd::Any,       State::Idle,      Act::None     },
+
+  { State::TapTouch,  Ev::Move,      Gd::Drag,      State::Drag,      Act::PressL   },
+  { State::TapTouch,  Ev::TapExpire, Gd::Drag,      State::Drag,      Act::PressL   },
+  { State::TapTouch,  Ev::Move,      Gd::Any,       State::Pointer,   Act::None     },
+  { State::TapTouch,  Ev::UpTap,     Gd::TapDouble, State::Idle,      Act::Click    },
+  { State::TapTouch,  Ev::UpTap,     Gd::TapClick,  State::Idle,      Act::Click    },
+  { State::TapTouch,  Ev::UpTap,     Gd::Any,       State::Idle,      Act::None     },
+  { State::TapTouch,  Ev::Up,        Gd::Any,       State::Idle,      Act::None     },
+
+  { State::Drag,      Ev::Up,        Gd::Lock,      State::DragLock,  Act::None     },
+  { State::Drag,      Ev::UpTap,     Gd::Lock,      State::DragLock,  Act::None     },
+  { State::Drag,      Ev::Up,        Gd::Any,       State::Idle,      Act::ReleaseL },
+  { State::Drag,      Ev::UpTap,     Gd::Any,       State::Idle,      Act::ReleaseL },
+
+  { State::DragLock,  Ev::Down,      Gd::Any,       State::DragTouch, Act::None     },
+  { State::DragLock,  Ev::EdgeDown,  Gd::Any,       State::DragTouch, Act::None     },
+  { State::DragLock,  Ev::Timeout,   Gd::Any,       State::Idle,      Act::ReleaseL },
+  { State::DragTouch, Ev::Move,      Gd::Any,       State::Drag,      Act::None     },
+  { State::DragTouch, Ev::TapExpire, Gd::Any,       State::Drag,      Act::None     },
+  { State::DragTouch, Ev::UpTap,     Gd::Any,       State::Idle,      Act::ReleaseL },
+  { State::DragTouch, Ev::Up,        Gd::Any,       State::DragLock,  Act::None     },
+
+  // 가장자리 착지도 움직이지 않고 떼면 일반 탭(스크롤은 이동이 있어야 출력되므로 탭 중에는 0)
+  { State::Scroll,    Ev::UpTap,     Gd::TapDouble, State::TapGap,    Act::None     },
+  { State::Scroll,    Ev::UpTap,     Gd::DragTap,   State::TapGap,    Act::Click    },
+  { State::Scroll,    Ev::UpTap,     Gd::TapClick,  State::Idle,      Act::Click    },
+  { State::Scroll,    Ev::UpTap,     Gd::Drag,      State::TapGap,    Act::None     },
+  { State::Scroll,    Ev::UpTap,     Gd::Any,       State::Idle,      Act::None     },
+  { State::Scroll,    Ev::Up,        Gd::Any,       State::Idle,      Act::None     },
+};
+
+constexpr int32_t SLOP_SUB = TouchPos::SUB / 2;   // 이동 판정(반 셀)
+constexpr int32_t EDGE_SUB = TouchPos::SUB;       // 가장자리 폭(1셀)
+
+constexpr uint32_t HAP_MS = 40;
+constexpr uint8_t  HAP_ARM = 1, HAP_DISARM = 12;  // DRV2605 라이브러리: 강한 클릭 / 트리플 클릭
+
+struct Ctx {
+  State      st = State::Idle;
+  ScrollAxis axis = ScrollAxis::None;
+  bool       touching = false;
+  bool       moved = false, expired = false, hold1 = false, hold2 = false, timedOut = false;
+  int32_t    x0 = 0, y0 = 0;
+  uint32_t   tDown = 0, tUp = 0;
+} C;
+
+bool guard(Gd g, const Timing& t){
+  switch (g){
+    case Gd::Any:       return true;
+    case Gd::TapClick:  return t.tapMode == TouchGesture::TAP_CLICK;
+    case Gd::TapDouble: return t.tapMode == TouchGesture::TAP_DOUBLE;
+    case Gd::Drag:      return t.drag != TouchGesture::DRAG_OFF;
+    case Gd::DragTap:   return t.drag != TouchGesture::DRAG_OFF && t.tapMode == TouchGesture::TAP_CLICK;
+    case Gd::Lock:      return t.drag == TouchGesture::DRAG_LOCK;
+    case Gd::HoldOn:    return t.holdMs != 0;
+  }
+  return false;
+}
+
+void run(Act a){
+  switch (a){
+    case Act::None:       break;
+    case Act::Click:      USBDevices::mouseClickLeft(); break;
+    case Act::ClickRight: USBDevices::mouseClickRight(); break;
+    case Act::PressL:     USBDevices::mousePressLeft(); break;
+    case Act::ReleaseL:   USBDevices::mouseReleaseLeft(); break;
+    case Act::Arm:        HapticsRuntime::LraPlay(HAP_MS, HAP_ARM); break;
+    case Act::Disarm:     HapticsRuntime::LraPlay(HAP_MS, HAP_DISARM); break;
+  }
+}
+
+void fire(Ev e, const Timing& t){
+  for (const Tr& r : kTable){
+    if (r.from != C.st || r.ev != e || !guard(r.gd, t)) continue;
+    C.st = r.to;
+    run(r.act);
+    return;
+  }
+}
+
+} // anon
+
+namespace TouchGesture {
+
+void reset(){
+  if (C.st == State::Drag || C.st == State::DragLock || C.st == State::DragTouch)
+    USBDevices::mouseReleaseLeft();
+  C = Ctx{};
+}
+
+void step(bool touching, int32_t x, int32_t y, uint32_t sample_ms, uint32_t now_ms, const Timing& t){
+  if (touching && !C.touching){
+    C.touching = true;
+    C.moved = C.expired = C.hold1 = C.hold2 = false;
+    C.x0 = x; C.y0 = y; C.tDown = sample_ms;
+    C.axis = !t.edge                                ? ScrollAxis::None
+           : (x >= TouchPos::X_MAX - EDGE_SUB)      ? ScrollAxis::Vertical
+           : (y <= TouchPos::Y_MIN + EDGE_SUB)      ? ScrollAxis::Horizontal
+           :                                          ScrollAxis::None;
+    fire((C.axis != ScrollAxis::None) ? Ev::EdgeDown : Ev::Down, t);
+    return;
+  }
+  if (!touching && C.touching){
+    C.touching = false;
+    C.tUp = sample_ms;
+    C.timedOut = false;
+    const bool tap = !C.moved && (sample_ms - C.tDown) <= t.tapMs;
+    fire(tap ? Ev::UpTap : Ev::Up, t);
+    return;
+  }
+
+  if (C.touching){
+    if (!C.moved){
+      const int32_t dx = x - C.x0, dy = y - C.y0;
+      if (dx > SLOP_SUB || dx < -SLOP_SUB || dy > SLOP_SUB || dy < -SLOP_SUB){
+        C.moved = true;
+        fire(Ev::Move, t);
+        return;
+      }
+    }
+    const uint32_t held = now_ms - C.tDown;
+    if (!C.expired && held > t.tapMs){ C.expired = true; fire(Ev::TapExpire, t); }
+    if (C.moved) return;
+    if (!C.hold1 && t.holdMs && held >= t.holdMs){ C.hold1 = true; fire(Ev::Hold1, t); }
+    if (!C.hold2 && t.holdMs && held >= t.hold2Ms){ C.hold2 = true; fire(Ev::Hold2, t); }
+    return;
+  }
+
+  if (!C.timedOut){
+    const uint32_t lim = (C.st == State::DragLock) ? t.lockMs : t.gapMs;
+    if (now_ms - C.tUp >= lim){ C.timedOut = true; fire(Ev::Timeout, t); }
+  }
+}
+
+State state(){ return C.st; }
+ScrollAxis scrollAxis(){ return (C.st == State::Scroll) ? C.axis : ScrollAxis::None; }
+
+const char* stateName(State s){
+  static const char* kNames[] = { "idle", "touch", "pointer", "hold", "holdoff", "tapgap",
+                                  "taptouch", "drag", "draglock", "dragtouch", "scroll" };
+  return ((uint8_t)s < (uint8_t)State::COUNT) ? kNames[(uint8_t)s] : "?";
+}
+
+} // namespace TouchGesture
@@ -0,0 +1,53 @@
+#pragma once
+//
+// TouchGestures — 터치패드 제스처 인식기(constexpr 전이 테이블 FSM)
+//  - 이벤트: 착지(Down/EdgeDown), 뗌(UpTap = tap_ms 이내·이동 없음 / Up), 이동(slop 초과 1회),
+//            TapExpire(tap_ms 경과), Hold1/Hold2(이동 없이 hold_ms/hold2_ms 경과), Timeout(뗀 뒤 간격 경과)
+//  - 테이블 kTable: (상태, 이벤트, 조건) → (다음 상태, 동작), 위에서부터 첫 일치 행 적용
+//  - 탭 → 뗌 즉시 클릭(대기 없음). 드래그가 켜져 있으면 클릭 뒤 tap_gap 안의 재착지가 드래그 후보
+//  - 탭-드래그 + 드래그 락: 손을 떼도 lock_ms 동안 버튼 유지, 재착지 탭으로 해제
+//  - 2단 홀드: hold_ms에 우클릭 준비(진동), 그 상태로 떼면 우클릭, hold2_ms까지 유지하면 취소
+//    (더 긴 홀드는 GestureEngine의 모드 토글 몫)
+//  - 가장자리 스크롤: 오른쪽 가장자리 착지 → 세로 휠, 아래 가장자리 → 가로(AC Pan)
+//    (이동 없이 tap_ms 안에 떼면 가운데와 같은 탭으로 처리)
+//  - 좌표는 TouchPos::SUB 단위, 시간은 ms(샘플 타임스탬프)
+//
+
+#include <stdint.h>
+
+namespace TouchGesture {
+
+enum class State : uint8_t {
+  Idle, Touch, Pointer, Hold, HoldOff, TapGap, TapTouch, Drag, DragLock, DragTouch, Scroll, COUNT
+};
+
+// 탭 모드
+enum : uint8_t { TAP_OFF = 0, TAP_CLICK = 1, TAP_DOUBLE = 2 };   // 끔 / 탭=클릭 / 더블탭만 클릭(기존)
+// 드래그 모드
+enum : uint8_t { DRAG_OFF = 0, DRAG_ON = 1, DRAG_LOCK = 2 };
+
+struct Timing {
+  uint8_t  tapMode  = TAP_CLICK;
+  uint16_t tapMs    = 180;    // 탭 최대 길이
+  uint16_t gapMs    = 300;    // 탭 뒤 재착지 허용 간격(드래그/더블탭)
+  uint8_t  drag     = DRAG_ON;
+  uint16_t lockMs   = 800;    // 드래그 락 유지
+  uint16_t holdMs   = 600;    // 0 = 홀드 우클릭 끔
+  uint16_t hold2Ms  = 1200;
+  bool     edge     = true;
+};
+
+// 스크롤 축(Scroll 상태일 때)
+enum class ScrollAxis : uint8_t { None, Vertical, Horizontal };
+
+void reset();
+
+// 매 tick 호출. touching/x/y: 최신 샘플, sample_ms: 샘플 시각, now_ms: 현재
+// 클릭/버튼은 여기서 USBDevices로 출력, 이동 처리는 호출자(state()/scrollAxis()로 분기)
+void step(bool touching, int32_t x, int32_t y, uint32_t sample_ms, uint32_t now_ms, const Timing& t);
+
+State      state();
+ScrollAxis scrollAxis();
+const char* stateName(State s);
+
+} // namespace TouchGesture
@@ -0,0 +1,80 @@
+#pragma once
+//
+// TouchInertia.h — 손을 뗀 뒤 관성(커서 글라이드/키네틱 스크롤)
+//  - 터치 중 샘플(타임스탬프 µs, SUB 좌표)을 최근 N개 링에 보관
+//  - 뗄 때: 뗌 시각 기준 WINDOW_MS 안의 샘플로 최소제곱 기울기 → 속도(SUB/s). 멈췄다 떼면 0
+//  - 이후 tick마다 Δ = v·dt 출력, v ← v·exp(-dt/τ). |v| < 정지 임계 또는 재착지 시 중단
+//  - 출력 단위 변환(셀/노치)과 전송은 파이프라인 몫
+//  - Arduino 의존성 없음(float 연산만)
+//
+
+#include <stdint.h>
+#include <math.h>
+
+namespace TouchInertia {
+
+inline constexpr uint8_t  N         = 8;     // 추적 주기(≥5ms) 기준 ≥40ms
+inline constexpr uint32_t WINDOW_MS = 80;    // 속도 추정 창
+inline constexpr uint8_t  MIN_PTS   = 3;
+
+struct Params {
+  float tauMs = 350.0f;   // 감쇠 시정수(클수록 멀리 미끄러짐)
+  float vStop = 32.0f;    // 정지 임계(SUB/s)
+};
+
+struct Glide {
+  uint64_t t[N] = {0};
+  int32_t  x[N] = {0}, y[N] = {0};
+  uint8_t  n = 0, head = 0;
+
+  float vx = 0.0f, vy = 0.0f;   // SUB/s
+  bool  active = false;
+
+  void clear(){ n = 0; head = 0; }
+  void stop(){ active = false; vx = vy = 0.0f; }
+
+  void push(uint64_t t_us, int32_t px, int32_t py){
+    t[head] = t_us; x[head] = px; y[head] = py;
+    head = (uint8_t)((head + 1) % N);
+    if (n < N) ++n;
+  }
+
+  // 뗌 시각 기준 속도 추정 → 정지 임계 이상이면 글라이드 시작
+  bool launch(uint64_t release_us, const Params& p){
+    stop();
+    const uint64_t win = (uint64_t)WINDOW_MS * 1000u;
+    float st = 0.0f, sx = 0.0f, sy = 0.0f, stt = 0.0f, stx = 0.0f, sty = 0.0f;
+    uint8_t k = 0;
+    for (uint8_t i = 0; i < n; ++i){
+      const uint8_t j = (uint8_t)((head + N - 1 - i) % N);   // 최신 → 과거
+      if (release_us - t[j] > win) break;
+      const float ts = -(float)(int64_t)(release_us - t[j]) * 1e-6f;   // 뗌 시각 = 0
+      st += ts; sx += (float)x[j]; sy += (float)y[j];
+      stt += ts * ts; stx += ts * (float)x[j]; sty += ts * (float)y[j];
+      ++k;
+    }
+    clear();
+    if (k < MIN_PTS) return false;
+    const float den = (float)k * stt - st * st;
+    if (!(den > 0.0f)) return false;
+    vx = ((float)k * stx - st * sx) / den;
+    vy = ((float)k * sty - st * sy) / den;
+    active = (vx * vx + vy * vy) > p.vStop * p.vStop;
+    if (!active) vx = vy = 0.0f;
+    return active;
+  }
+
+  // dtS 동안의 이동량(SUB). 끝나면 false
+  bool step(float dtS, const Params& p, float& dx, float& dy){
+    dx = dy = 0.0f;
+    if (!active) return false;
+    dx = vx * dtS;
+    dy = vy * dtS;
+    const float k = expf(-dtS * 1000.0f / p.tauMs);
+    vx *= k; vy *= k;
+    if (vx * vx + vy * vy < p.vStop * p.vStop) stop();
+    return true;
+  }
+};
+
+} // namespace TouchInertia
@@ -3,26 +3,66 @@
 #include "../usb/USBDevices.h"
 #include "../core/ConfigStore.h"
 #include "../core/Log.h"
+#include "TouchPosition.h"
+#include "PointerBallistics.h"
+#include "TouchGestures.h"
+#include "TouchInertia.h"
 
 namespace {
 
 struct State {
   bool touching = false;
-  int  sx = 0, sy = 0;     // start
+  int  sx = 0, sy = 0;     // start        (TouchPos::SUB 단위 — 셀당 16)
   int  px = 0, py = 0;     // prev / last
   uint32_t t_touch = 0;
   uint32_t t_release = 0;
 
-  // tap
-  uint32_t lastTap = 0;
-  bool firstTapPending = false;
+  // 1€ 필터(셀 좌표) — 커서 가속/소수부 캐리는 PointerBallistics
+  OneEuro::Filter fx, fy;
+  float    qx = 0.f, qy = 0.f;   // 직전 필터 좌표
+  uint64_t lastUs = 0;
+
+  // 최신 MPR121 샘플(IRQ/터치 중 주기 갱신) — 착지/뗌 시각은 샘플 타임스탬프 기준
+  HAL::TouchSample ts;
+  TouchPos::Pos    pos;    // 샘플별 서브셀 무게중심
+
+  // 관성: 뗄 때 속도 추정 → 커서/휠로 감쇠 출력
+  TouchInertia::Glide      glide;
+  bool                     glideWheel = false;
+  TouchGesture::ScrollAxis glideAxis = TouchGesture::ScrollAxis::None;
+  float                    wcarry = 0.f;   // 휠 1/16 노치 소수부
 } S;
 
-constexpr uint8_t  DEADZONE = 1;
-constexpr uint16_t TAP_MAX  = 180;
-constexpr uint16_t DBL_GAP  = 300;
+uint8_t         s_fMode = OneEuro::MODE_OFF;
+OneEuro::Params s_fp{ 1.5f, 0.3f, 1.0f };
+
+// 제스처 타이밍은 ConfigStore에서 매 tick 읽음(CLI 변경 즉시 반영)
+inline TouchGesture::Timing gestureTiming(const ConfigStore::Config& cfg){
+  TouchGesture::Timing t;
+  t.tapMode = cfg.tp_tap_mode;
+  t.tapMs   = cfg.tp_tap_ms;
+  t.gapMs   = cfg.tp_gap_ms;
+  t.drag    = cfg.tp_drag;
+  t.lockMs  = cfg.tp_lock_ms;
+  t.holdMs  = cfg.tp_hold_ms;
+  t.hold2Ms = cfg.tp_hold2_ms;
+  t.edge    = cfg.tp_edge;
+  return t;
+}
 
-inline int iround(float f){ return (int)((f>0)?(f+0.5f):(f-0.5f)); }
+inline TouchInertia::Params inertiaParams(const ConfigStore::Config& cfg){
+  TouchInertia::Params p;
+  p.tauMs = (float)cfg.tp_in_tau_ms;
+  p.vStop = cfg.tp_in_stop * (float)TouchPos::SUB;   // 셀/s → SUB/s
+  return p;
+}
+
+// 셀 단위 이동 → 가속 곡선 × 게인 → 정수 픽셀(나머지 이월)
+inline void emitMove(float dxC, float dyC, float gain, float dtS){
+  int dx, dy;
+  PointerBallistics::step(dxC, dyC, gain, dtS, dx, dy);
+  if (dx || dy) USBDevices::mouseMove(dx, dy, 0);
+}
 
 } // anon
 
@@ -30,52 +70,126 @@ namespace TouchPad {
 
 void init(){
   S = State{};
+  TouchGesture::reset();
+}
+
+void setBallistics(const PointerBallistics::Params& p){
+  PointerBallistics::configure(p);
+}
+
+void setFilter(uint8_t mode, const OneEuro::Params& p){
+  s_fp = p;
+  s_fMode = mode;
+}
+
+uint8_t filterMode(){ return s_fMode; }
+
+void filterCutoffs(float out[2]){
+  const bool oe = (s_fMode == OneEuro::MODE_ONE_EURO);
+  out[0] = oe ? S.fx.fc : 0.0f;
+  out[1] = oe ? S.fy.fc : 0.0f;
 }
 
-void tick(uint32_t now_ms){
-  HAL::TouchPt p;
-  const bool ok = HAL::touchGetCoord(p);
+void tick(const HAL::InputFrame& in, uint32_t now_ms){
+  const bool fresh = HAL::touchPoll(S.ts, in.t_us);
+  if (fresh) TouchPos::centroid(S.ts, S.pos);
+  const bool ok = S.ts.valid;
+  const TouchPos::Pos& p = S.pos;
+  const uint32_t sample_ms = (uint32_t)(S.ts.t_us / 1000u);
+  constexpr float kInvSub = 1.0f / (float)TouchPos::SUB;
 
-  float gain = ConfigStore::get().cursor_gain;
+  const auto& cfg = ConfigStore::get();
+  float gain = cfg.cursor_gain;
+
+  // 뗌 직전 제스처(관성 대상 판정)
+  const TouchGesture::State      prevSt   = TouchGesture::state();
+  const TouchGesture::ScrollAxis prevAxis = TouchGesture::scrollAxis();
+
+  // 제스처 FSM(클릭/드래그 버튼/홀드 우클릭은 여기서 출력) — 탭은 뗌 샘플에서 바로 클릭
+  TouchGesture::step(ok, p.x, p.y, sample_ms, now_ms, gestureTiming(cfg));
 
   if (ok && !S.touching){
     S.touching = true;
     S.sx = S.px = p.x;
     S.sy = S.py = p.y;
-    S.t_touch  = now_ms;
+    S.t_touch  = sample_ms;
+    // 필터는 착지 좌표에서 시작(셀 단위)
+    S.fx.prime((float)p.x * kInvSub, s_fp.minCutoff);
+    S.fy.prime((float)p.y * kInvSub, s_fp.minCutoff);
+    S.qx = (float)p.x * kInvSub; S.qy = (float)p.y * kInvSub;
+    PointerBallistics::reset();
+    S.glide.stop();
+    S.glide.clear();
+    S.glide.push(S.ts.t_us, p.x, p.y);
+    S.lastUs = in.t_us;
     return;
   }
-  if (ok && S.touching){
-    const int dx_raw = p.x - S.px;
-    const int dy_raw = S.py - p.y;        // Y↑ = 화면↑
-
-    const int dx = iround(dx_raw * gain);
-    const int dy = iround(dy_raw * gain);
-
-    if (abs(dx) + abs(dy) >= DEADZONE){
-      USBDevices::mouseMove(dx, dy, 0);
-      S.px = p.x; S.py = p.y;
+  if (ok && fresh) S.glide.push(S.ts.t_us, p.x, p.y);
+  if (ok && S.touching && TouchGesture::scrollAxis() != TouchGesture::ScrollAxis::None){
+    // 가장자리 스크롤: 서브셀 Δ를 1/16 노치로 그대로(1셀 = 1노치)
+    if (TouchGesture::scrollAxis() == TouchGesture::ScrollAxis::Vertical){
+      if (p.y != S.py) USBDevices::mouseWheelFine(p.y - S.py);   // 위로 쓸면 위로 스크롤
+    } else {
+      if (p.x != S.px) USBDevices::mousePanFine(p.x - S.px);
     }
+    S.lastUs = in.t_us;
+    S.px = p.x; S.py = p.y;
+    return;
+  }
+  if (ok && S.touching && s_fMode == OneEuro::MODE_ONE_EURO){
+    const float dtS = (float)(uint32_t)(in.t_us - S.lastUs) * 1e-6f;
+    S.lastUs = in.t_us;
+    const float fxv = S.fx.step((float)p.x * kInvSub, dtS, s_fp);
+    const float fyv = S.fy.step((float)p.y * kInvSub, dtS, s_fp);
+
+    // 필터 좌표 변화량(셀)
+    emitMove(fxv - S.qx, S.qy - fyv, gain, dtS);   // Y↑ = 화면↑
+    S.qx = fxv; S.qy = fyv;
+    S.px = p.x; S.py = p.y;
+    return;
+  }
+  if (ok && S.touching){
+    // 서브셀 변화량(셀)
+    const float dtS = (float)(uint32_t)(in.t_us - S.lastUs) * 1e-6f;
+    S.lastUs = in.t_us;
+    emitMove((float)(p.x - S.px) * kInvSub, (float)(S.py - p.y) * kInvSub, gain, dtS);   // Y↑ = 화면↑
+    S.px = p.x; S.py = p.y;
     return;
   }
   if (!ok && S.touching){
     S.touching = false;
-    S.t_release = now_ms;
-    const uint32_t dur = S.t_release - S.t_touch;
-
-    if (dur <= TAP_MAX){
-      if (S.firstTapPending && (S.t_release - S.lastTap) <= DBL_GAP) {
-        USBDevices::mouseClickLeft();
-        S.firstTapPending = false;
-      } else {
-        S.firstTapPending = true;
-        S.lastTap = S.t_release;
-      }
+    S.t_release = sample_ms;
+
+    // 포인터 이동은 tp_inertia 2, 가장자리 스크롤은 1 이상에서 관성(탭/드래그/홀드는 제외)
+    const bool wheel  = (prevSt == TouchGesture::State::Scroll) && cfg.tp_inertia >= 1;
+    const bool cursor = (prevSt == TouchGesture::State::Pointer) && cfg.tp_inertia >= 2;
+    S.glide.stop();
+    if (wheel || cursor){
+      S.glideWheel = wheel;
+      S.glideAxis  = prevAxis;
+      S.wcarry     = 0.f;
+      S.glide.launch(S.ts.t_us, inertiaParams(cfg));
+    } else {
+      S.glide.clear();
     }
+    S.lastUs = in.t_us;
+    return;
   }
-
-  if (S.firstTapPending && (now_ms - S.lastTap) > DBL_GAP){
-    S.firstTapPending = false;
+  if (!ok && S.glide.active){
+    const float dtS = (float)(uint32_t)(in.t_us - S.lastUs) * 1e-6f;
+    S.lastUs = in.t_us;
+    float dx, dy;   // SUB
+    if (!S.glide.step(dtS, inertiaParams(cfg), dx, dy)) return;
+    if (S.glideWheel){
+      S.wcarry += (S.glideAxis == TouchGesture::ScrollAxis::Horizontal) ? dx : dy;
+      const int n = (int)S.wcarry;
+      if (!n) return;
+      S.wcarry -= (float)n;
+      if (S.glideAxis == TouchGesture::ScrollAxis::Horizontal) USBDevices::mousePanFine(n);
+      else                                                     USBDevices::mouseWheelFine(n);
+    } else {
+      emitMove(dx * kInvSub, -dy * kInvSub, gain, dtS);   // Y↑ = 화면↑
+    }
   }
 }
 
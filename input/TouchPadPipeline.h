@@ -1,13 +1,27 @@
 #pragma once
 //
 // TouchPadPipeline — CapaTouch → 마우스 커서/탭
+//  - 입력은 HAL::touchPoll 샘플(MPR121 IRQ 때만 I2C 버스트), 탭 시간은 샘플 타임스탬프 기준
 //
 
 #include <stdint.h>
+#include "../hal/HAL.h"
+#include "OneEuroFilter.h"
+#include "PointerBallistics.h"
 
 namespace TouchPad {
 
 void init();
-void tick(uint32_t now_ms);
+void tick(const HAL::InputFrame& in, uint32_t now_ms);
+
+// 좌표 필터: OneEuro::MODE_OFF(기존, 원시 좌표) / OneEuro::MODE_ONE_EURO
+// 1€ 파라미터 단위: 터치 셀 좌표, 속도 = 셀/s
+void setFilter(uint8_t mode, const OneEuro::Params& p);
+uint8_t filterMode();
+// 마지막 유효 컷오프(Hz): X, Y (필터 OFF면 0)
+void filterCutoffs(float out[2]);
+
+// 커서 가속 곡선(셀/s 속도 → 게인 배율 LUT). enabled=false면 선형 게인
+void setBallistics(const PointerBallistics::Params& p);
 
 } // namespace TouchPad
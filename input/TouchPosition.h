@@ -0,0 +1,70 @@
+#pragma once
+//
+// TouchPosition.h — MPR121 전극 데이터 → 서브셀 터치 좌표(고정소수점 가중 무게중심)
+//  - 전극 신호 d = 베이스라인×4 - 필터값(터치 시 필터값이 내려감), NOISE 이하는 0
+//  - 축마다 신호 최대 전극 ±1 창에서 무게중심: Σ d·위치 / Σ d (정수 연산, 반올림)
+//  - 전극 i 위치 = (2i+1)·SUB → 격자 좌표(HAL::Const::CX/CY)와 같은 범위를 SUB배 해상도로
+//  - 유효 판정은 기존 격자와 동일(양 축 모두 닿은 전극 있음), 신호가 없으면 격자 좌표로 폴백
+//
+
+#include <stdint.h>
+#include "../hal/HAL.h"
+
+namespace TouchPos {
+
+inline constexpr int32_t SUB_SHIFT = 4;
+inline constexpr int32_t SUB       = 1 << SUB_SHIFT;   // 셀당 16단계
+inline constexpr int32_t NOISE     = 2;                // 필터 카운트
+
+// 좌표 범위(SUB 단위)
+inline constexpr int32_t X_MIN = HAL::Const::CX_MIN * SUB, X_MAX = HAL::Const::CX_MAX * SUB;
+inline constexpr int32_t Y_MIN = HAL::Const::CY_MIN * SUB, Y_MAX = HAL::Const::CY_MAX * SUB;
+
+struct Pos {
+  int32_t x = 0, y = 0;   // SUB 단위(X 반전 적용 — HAL::TouchPt와 같은 방향)
+  bool    valid = false;
+};
+
+inline int32_t signal(const HAL::TouchSample& s, uint8_t e){
+  const int32_t d = (int32_t)s.base[e] * 4 - (int32_t)s.filt[e];
+  return (d > NOISE) ? d - NOISE : 0;
+}
+
+// 축 무게중심(SUB 단위, 1..(2n-1)·SUB). 신호가 없으면 -1
+inline int32_t axisCentroid(const HAL::TouchSample& s, uint8_t first, uint8_t count){
+  uint8_t peak = 0;
+  int32_t best = 0;
+  for (uint8_t i = 0; i < count; ++i){
+    const int32_t d = signal(s, first + i);
+    if (d > best){ best = d; peak = i; }
+  }
+  if (!best) return -1;
+
+  const uint8_t lo = peak ? peak - 1 : 0;
+  const uint8_t hi = (peak + 1 < count) ? peak + 1 : peak;
+  int32_t sw = 0, swp = 0;
+  for (uint8_t i = lo; i <= hi; ++i){
+    const int32_t d = signal(s, first + i);
+    sw  += d;
+    swp += d * ((2 * i + 1) * SUB);
+  }
+  return (swp + sw / 2) / sw;
+}
+
+inline int32_t clampI(int32_t v, int32_t lo, int32_t hi){ return (v < lo) ? lo : (v > hi) ? hi : v; }
+
+inline bool centroid(const HAL::TouchSample& s, Pos& out){
+  out.valid = s.valid;
+  if (!s.valid) return false;
+
+  int32_t x = axisCentroid(s, HAL::Const::TOUCH_X_FIRST, HAL::Const::TOUCH_X_COUNT);
+  int32_t y = axisCentroid(s, HAL::Const::TOUCH_Y_FIRST, HAL::Const::TOUCH_Y_COUNT);
+  // X 반전은 HAL 격자와 동일: x' = (CX_MAX+1) - x
+  x = (x < 0) ? s.pt.x * SUB : (HAL::Const::CX_MAX + 1) * SUB - x;
+  y = (y < 0) ? s.pt.y * SUB : y;
+  out.x = clampI(x, X_MIN, X_MAX);
+  out.y = clampI(y, Y_MIN, Y_MAX);
+  return true;
+}
+
+} // namespace TouchPos
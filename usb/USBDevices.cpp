@@ -1,24 +1,596 @@
 #include "USBDevices.h"
 
 #include <USB.h>
-#include <USBHIDMouse.h>
-#include <USBHIDKeyboard.h>
-#include <USBHIDGamepad.h>
+#include "esp32-hal-tinyusb.h"
+#include "tusb.h"
+
+#include "../core/BuildOpts.h"
+#include "../vendor/VendorHID.h"
 
 namespace {
-  USBHIDMouse     gMouse;
-  USBHIDKeyboard  gKeyboard;
-  USBHIDGamepad   gGamepad;
+  using USBDev::Itf;
+  using USBDev::TxStats;
+
+  // HID 인스턴스 0 하나에 키보드/마우스/게임패드 리포트 ID를 묶음
+  // (Arduino USBHID 클래스 대신 직접 등록 — 인터페이스 디스크립터의 bInterval을 설정하기 위함)
+  constexpr uint8_t HID_ITF = 0;
+  enum : uint8_t { RID_KEYBOARD = 1, RID_MOUSE = 2, RID_GAMEPAD = 3, RID_MOUSE_RES = 4 };
+
+  // 마우스: TinyUSB 마우스와 같은 입력 레이아웃(buttons, x, y, wheel, pan)
+  //  + 휠/AC Pan 각각 Resolution Multiplier 피처(2비트씩, 물리 1..16)
+  //  호스트가 피처를 1로 설정하면 휠 1단위 = 1/16 노치(고해상도), 아니면 기존 노치 단위
+  #define MOUSE_HIRES_DESC(rid, ridRes) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     ) ,\
+    HID_USAGE      ( HID_USAGE_DESKTOP_MOUSE    ) ,\
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION ) ,\
+      HID_REPORT_ID ( rid ) \
+      HID_USAGE      ( HID_USAGE_DESKTOP_POINTER ) ,\
+      HID_COLLECTION ( HID_COLLECTION_PHYSICAL   ) ,\
+        HID_USAGE_PAGE   ( HID_USAGE_PAGE_BUTTON  ) ,\
+        HID_USAGE_MIN    ( 1                      ) ,\
+        HID_USAGE_MAX    ( 5                      ) ,\
+        HID_LOGICAL_MIN  ( 0                      ) ,\
+        HID_LOGICAL_MAX  ( 1                      ) ,\
+        HID_REPORT_COUNT ( 5                      ) ,\
+        HID_REPORT_SIZE  ( 1                      ) ,\
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        HID_REPORT_COUNT ( 1                      ) ,\
+        HID_REPORT_SIZE  ( 3                      ) ,\
+        HID_INPUT        ( HID_CONSTANT           ) ,\
+        HID_USAGE_PAGE   ( HID_USAGE_PAGE_DESKTOP ) ,\
+        HID_USAGE        ( HID_USAGE_DESKTOP_X    ) ,\
+        HID_USAGE        ( HID_USAGE_DESKTOP_Y    ) ,\
+        HID_LOGICAL_MIN  ( 0x81                   ) ,\
+        HID_LOGICAL_MAX  ( 0x7f                   ) ,\
+        HID_REPORT_COUNT ( 2                      ) ,\
+        HID_REPORT_SIZE  ( 8                      ) ,\
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_RELATIVE ) ,\
+        HID_COLLECTION   ( HID_COLLECTION_LOGICAL ) ,\
+          HID_REPORT_ID      ( ridRes ) \
+          HID_USAGE          ( HID_USAGE_DESKTOP_RESOLUTION_MULTIPLIER ) ,\
+          HID_LOGICAL_MIN    ( 0                  ) ,\
+          HID_LOGICAL_MAX    ( 1                  ) ,\
+          HID_PHYSICAL_MIN   ( 1                  ) ,\
+          HID_PHYSICAL_MAX   ( 16                 ) ,\
+          HID_REPORT_COUNT   ( 1                  ) ,\
+          HID_REPORT_SIZE    ( 2                  ) ,\
+          HID_FEATURE        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+          HID_REPORT_ID      ( rid ) \
+          HID_USAGE          ( HID_USAGE_DESKTOP_WHEEL ) ,\
+          HID_LOGICAL_MIN    ( 0x81               ) ,\
+          HID_LOGICAL_MAX    ( 0x7f               ) ,\
+          HID_PHYSICAL_MIN   ( 0                  ) ,\
+          HID_PHYSICAL_MAX   ( 0                  ) ,\
+          HID_REPORT_COUNT   ( 1                  ) ,\
+          HID_REPORT_SIZE    ( 8                  ) ,\
+          HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_RELATIVE ) ,\
+        HID_COLLECTION_END ,\
+        HID_COLLECTION   ( HID_COLLECTION_LOGICAL ) ,\
+          HID_REPORT_ID      ( ridRes ) \
+          HID_USAGE          ( HID_USAGE_DESKTOP_RESOLUTION_MULTIPLIER ) ,\
+          HID_LOGICAL_MIN    ( 0                  ) ,\
+          HID_LOGICAL_MAX    ( 1                  ) ,\
+          HID_PHYSICAL_MIN   ( 1                  ) ,\
+          HID_PHYSICAL_MAX   ( 16                 ) ,\
+          HID_REPORT_COUNT   ( 1                  ) ,\
+          HID_REPORT_SIZE    ( 2                  ) ,\
+          HID_FEATURE        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+          HID_PHYSICAL_MIN   ( 0                  ) ,\
+          HID_PHYSICAL_MAX   ( 0                  ) ,\
+          HID_REPORT_SIZE    ( 4                  ) ,\
+          HID_FEATURE        ( HID_CONSTANT       ) ,\
+          HID_REPORT_ID      ( rid ) \
+          HID_USAGE_PAGE     ( HID_USAGE_PAGE_CONSUMER ) ,\
+          HID_USAGE_N        ( HID_USAGE_CONSUMER_AC_PAN, 2 ) ,\
+          HID_LOGICAL_MIN    ( 0x81               ) ,\
+          HID_LOGICAL_MAX    ( 0x7f               ) ,\
+          HID_REPORT_COUNT   ( 1                  ) ,\
+          HID_REPORT_SIZE    ( 8                  ) ,\
+          HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_RELATIVE ) ,\
+        HID_COLLECTION_END ,\
+      HID_COLLECTION_END ,\
+    HID_COLLECTION_END
+
+  // 벤더 컬렉션(Usage Page 0xFF00): INPUT/OUTPUT/FEATURE 각각 n바이트(리포트 ID 제외) — VendorHID가 처리
+  #define VENDOR_DESC(ridIn, ridOut, ridFeat, n) \
+    HID_USAGE_PAGE_N ( HID_USAGE_PAGE_VENDOR, 2     ) ,\
+    HID_USAGE        ( 0x01                         ) ,\
+    HID_COLLECTION   ( HID_COLLECTION_APPLICATION   ) ,\
+      HID_LOGICAL_MIN   ( 0x00                      ) ,\
+      HID_LOGICAL_MAX_N ( 0xFF, 2                   ) ,\
+      HID_REPORT_SIZE   ( 8                         ) ,\
+      HID_REPORT_COUNT  ( n                         ) ,\
+      HID_REPORT_ID     ( ridIn )                     \
+      HID_USAGE         ( 0x01                      ) ,\
+      HID_INPUT         ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+      HID_REPORT_ID     ( ridOut )                    \
+      HID_USAGE         ( 0x02                      ) ,\
+      HID_OUTPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+      HID_REPORT_ID     ( ridFeat )                   \
+      HID_USAGE         ( 0x03                      ) ,\
+      HID_FEATURE       ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+    HID_COLLECTION_END
+
+  // 표준: TinyUSB 게임패드(int8 X/Y/Z/RZ/RX/RY + hat + 32버튼)
+  const uint8_t kReportDescStd[] = {
+    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(RID_KEYBOARD)),
+    MOUSE_HIRES_DESC            (RID_MOUSE, RID_MOUSE_RES),
+    TUD_HID_REPORT_DESC_GAMEPAD (HID_REPORT_ID(RID_GAMEPAD)),
+    VENDOR_DESC                 (VendorHID::RID_INPUT, VendorHID::RID_OUTPUT, VendorHID::RID_FEATURE,
+                                 VendorHID::REPORT_LEN - 1),
+  };
+
+  // 고해상도 게임패드: int16 X/Y/RX/RY + uint16 트리거(Z/RZ) + hat + 32버튼
+  #define PAD_HIRES_ITEMS \
+      HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP           ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_X              ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_Y              ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_RX             ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_RY             ) ,\
+      HID_LOGICAL_MIN_N  ( -32767, 2                        ) ,\
+      HID_LOGICAL_MAX_N  ( 32767, 2                         ) ,\
+      HID_REPORT_COUNT   ( 4                                ) ,\
+      HID_REPORT_SIZE    ( 16                               ) ,\
+      HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_Z              ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_RZ             ) ,\
+      HID_LOGICAL_MIN    ( 0                                ) ,\
+      HID_LOGICAL_MAX_N  ( 32767, 2                         ) ,\
+      HID_REPORT_COUNT   ( 2                                ) ,\
+      HID_REPORT_SIZE    ( 16                               ) ,\
+      HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_HAT_SWITCH     ) ,\
+      HID_LOGICAL_MIN    ( 1                                ) ,\
+      HID_LOGICAL_MAX    ( 8                                ) ,\
+      HID_PHYSICAL_MIN   ( 0                                ) ,\
+      HID_PHYSICAL_MAX_N ( 315, 2                           ) ,\
+      HID_REPORT_COUNT   ( 1                                ) ,\
+      HID_REPORT_SIZE    ( 8                                ) ,\
+      HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+      HID_USAGE_PAGE     ( HID_USAGE_PAGE_BUTTON            ) ,\
+      HID_USAGE_MIN      ( 1                                ) ,\
+      HID_USAGE_MAX      ( 32                               ) ,\
+      HID_LOGICAL_MIN    ( 0                                ) ,\
+      HID_LOGICAL_MAX    ( 1                                ) ,\
+      HID_REPORT_COUNT   ( 32                               ) ,\
+      HID_REPORT_SIZE    ( 1                                ) ,\
+      HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,
+
+  // 통합 리포트 뒤쪽: 포인터(버튼 33..37 + 상대 X/Y/휠 + AC Pan)
+  #define COMBO_POINTER_ITEMS \
+      HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP           ) ,\
+      HID_USAGE          ( HID_USAGE_DESKTOP_POINTER        ) ,\
+      HID_COLLECTION     ( HID_COLLECTION_PHYSICAL          ) ,\
+        HID_USAGE_PAGE   ( HID_USAGE_PAGE_BUTTON            ) ,\
+        HID_USAGE_MIN    ( 33                               ) ,\
+        HID_USAGE_MAX    ( 37                               ) ,\
+        HID_LOGICAL_MIN  ( 0                                ) ,\
+        HID_LOGICAL_MAX  ( 1                                ) ,\
+        HID_REPORT_COUNT ( 5                                ) ,\
+        HID_REPORT_SIZE  ( 1                                ) ,\
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        HID_REPORT_COUNT ( 1                                ) ,\
+        HID_REPORT_SIZE  ( 3                                ) ,\
+        HID_INPUT        ( HID_CONSTANT                     ) ,\
+        HID_USAGE_PAGE   ( HID_USAGE_PAGE_DESKTOP           ) ,\
+        HID_USAGE        ( HID_USAGE_DESKTOP_X              ) ,\
+        HID_USAGE        ( HID_USAGE_DESKTOP_Y              ) ,\
+        HID_USAGE        ( HID_USAGE_DESKTOP_WHEEL          ) ,\
+        HID_LOGICAL_MIN  ( 0x81                             ) ,\
+        HID_LOGICAL_MAX  ( 0x7f                             ) ,\
+        HID_REPORT_COUNT ( 3                                ) ,\
+        HID_REPORT_SIZE  ( 8                                ) ,\
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_RELATIVE ) ,\
+        HID_USAGE_PAGE   ( HID_USAGE_PAGE_CONSUMER          ) ,\
+        HID_USAGE_N      ( HID_USAGE_CONSUMER_AC_PAN, 2     ) ,\
+        HID_LOGICAL_MIN  ( 0x81                             ) ,\
+        HID_LOGICAL_MAX  ( 0x7f                             ) ,\
+        HID_REPORT_COUNT ( 1                                ) ,\
+        HID_REPORT_SIZE  ( 8                                ) ,\
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_RELATIVE ) ,\
+      HID_COLLECTION_END ,
+
+  #define PAD_DESC(...) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     ) ,\
+    HID_USAGE      ( HID_USAGE_DESKTOP_GAMEPAD  ) ,\
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION ) ,\
+      __VA_ARGS__ \
+    HID_COLLECTION_END
+
+  const uint8_t kReportDescHiRes[] = {
+    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(RID_KEYBOARD)),
+    MOUSE_HIRES_DESC            (RID_MOUSE, RID_MOUSE_RES),
+    PAD_DESC                    (HID_REPORT_ID(RID_GAMEPAD) PAD_HIRES_ITEMS),
+    VENDOR_DESC                 (VendorHID::RID_INPUT, VendorHID::RID_OUTPUT, VendorHID::RID_FEATURE,
+                                 VendorHID::REPORT_LEN - 1),
+  };
+
+  // 통합: 게임패드(고해상도) + 포인터를 리포트 ID 하나로 — 마우스 리포트 ID 없음
+  const uint8_t kReportDescCombo[] = {
+    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(RID_KEYBOARD)),
+    PAD_DESC                    (HID_REPORT_ID(RID_GAMEPAD) PAD_HIRES_ITEMS COMBO_POINTER_ITEMS),
+    VENDOR_DESC                 (VendorHID::RID_INPUT, VendorHID::RID_OUTPUT, VendorHID::RID_FEATURE,
+                                 VendorHID::REPORT_LEN - 1),
+  };
+
+  struct __attribute__((packed)) PadReportHiRes {
+    int16_t  x, y, rx, ry;     // Q15 그대로(-32767..+32767)
+    uint16_t lt, rt;           // 0..32767
+    uint8_t  hat;
+    uint32_t buttons;
+  };
+
+  struct __attribute__((packed)) ComboReport {
+    PadReportHiRes pad;
+    uint8_t  mbuttons;         // 포인터 버튼(bit0 L, bit1 R, bit2 M ...)
+    int8_t   dx, dy, wheel, pan;
+  };
+
+  union PadReport {
+    hid_gamepad_report_t std;
+    PadReportHiRes       hi;
+    ComboReport          combo;
+  };
+
+  uint8_t gPollMs = CFG_USB_POLL_MS;      // bInterval(ms) — 열거 시점에 고정
+  bool    gPadHiRes = CFG_PAD_HIRES;      // 게임패드 리포트 형식 — 열거 시점에 고정
+  bool    gCombined = CFG_USB_COMBINED;   // 게임패드+포인터 통합 리포트 — 열거 시점에 고정
+  bool    gBegun  = false;
+
+  // 통합 모드의 게임패드 축은 항상 int16
+  inline bool padWide(){ return gPadHiRes || gCombined; }
+
+  inline uint8_t padReportLen(){
+    if (gCombined) return sizeof(ComboReport);
+    return gPadHiRes ? sizeof(PadReportHiRes) : sizeof(hid_gamepad_report_t);
+  }
+
+  inline const uint8_t* reportDesc(uint16_t& len){
+    if (gCombined){ len = sizeof(kReportDescCombo); return kReportDescCombo; }
+    if (gPadHiRes){ len = sizeof(kReportDescHiRes); return kReportDescHiRes; }
+    len = sizeof(kReportDescStd);
+    return kReportDescStd;
+  }
+
+  // Resolution Multiplier 피처 값(호스트가 SET_REPORT로 설정, bit0-1 휠 / bit2-3 팬)
+  volatile uint8_t gResMul = 0;
+
+  inline bool wheelHiRes(){ return !gCombined && (gResMul & 0x03); }
+  inline bool panHiRes()  { return !gCombined && (gResMul & 0x0C); }
+
+  // 1/16 노치 → 리포트 단위. 배수가 꺼져 있으면 노치로 모으고 나머지는 다음 호출로 이월
+  inline int32_t fineToUnits(int32_t fine, int32_t& rem, bool hires){
+    if (hires) return fine;
+    rem += fine;
+    const int32_t n = rem / USBDev::WHEEL_FINE_PER_NOTCH;
+    rem -= n * USBDev::WHEEL_FINE_PER_NOTCH;
+    return n;
+  }
+
+  inline bool validPoll(uint8_t ms){ return ms == 1 || ms == 2 || ms == 4 || ms == 8; }
+
+  // 설정 디스크립터 조립 시 TinyUSB 헬퍼가 호출
+  uint16_t loadHidDescriptor(uint8_t* dst, uint8_t* itf){
+    const uint8_t str   = tinyusb_add_string_descriptor("ComboPad HID");
+    const uint8_t epIn  = tinyusb_get_free_in_endpoint();
+    const uint8_t epOut = tinyusb_get_free_out_endpoint();
+    if (!epIn || !epOut) return 0;
+
+    uint16_t descLen = 0;
+    reportDesc(descLen);
+    const uint8_t d[TUD_HID_INOUT_DESC_LEN] = {
+      TUD_HID_INOUT_DESCRIPTOR(*itf, str, HID_ITF_PROTOCOL_NONE, descLen,
+                               epOut, (uint8_t)(0x80 | epIn), CFG_TUD_HID_EP_BUFSIZE, gPollMs)
+    };
+    *itf += 1;
+    memcpy(dst, d, sizeof(d));
+    return sizeof(d);
+  }
+
+  // ---- 송신 큐(인터페이스별 링) ----
+  // 엔드포인트가 바쁘면 보내지 않고 다음 flush에서 다시 시도(블로킹 없음)
+  template <typename R, uint8_t N>
+  struct TxQueue {
+    R       buf[N];
+    uint8_t head = 0, count = 0;
+
+    bool empty() const { return count == 0; }
+    bool full()  const { return count >= N; }
+    R&   front()       { return buf[head]; }
+    R&   tail()        { return buf[(head + count - 1) % N]; }
+    void push(const R& r){ buf[(head + count) % N] = r; count++; }
+    void pop()         { head = (uint8_t)((head + 1) % N); count--; }
+    void clear()       { head = 0; count = 0; }
+  };
+
+  TxStats gStats[(uint8_t)Itf::COUNT];
+  uint8_t gRR = 0;                        // 드레인 라운드로빈 시작 인터페이스
+
+  // 실측 리포트 속도: 1초 창마다 sent 증가분으로 계산
+  constexpr uint32_t RATE_WINDOW_MS = 1000;
+  uint32_t gRateT0 = 0;
+  uint32_t gRateSent0[(uint8_t)Itf::COUNT] = {0};
+
+  void updateRates(uint32_t now_ms){
+    const uint32_t dt = now_ms - gRateT0;
+    if (dt < RATE_WINDOW_MS) return;
+    for (uint8_t i = 0; i < (uint8_t)Itf::COUNT; ++i){
+      gStats[i].rateHz = (uint16_t)(((gStats[i].sent - gRateSent0[i]) * 1000u + dt / 2) / dt);
+      gRateSent0[i] = gStats[i].sent;
+    }
+    gRateT0 = now_ms;
+  }
+
+  inline TxStats& st(Itf i){ return gStats[(uint8_t)i]; }
+
+  // ---- Mouse 상태 ----
+  struct MouseState {
+    uint8_t buttons = 0;        // 유지 버튼
+    uint8_t clickNow = 0;       // 이번 flush에 누를 클릭
+    int32_t dx = 0, dy = 0, wheel = 0, pan = 0;   // wheel/pan: 리포트 단위(배수 적용 후)
+    int32_t wheelFine = 0, panFine = 0;           // 배수 미적용 시 노치 미만 나머지(1/16 노치)
+    uint8_t sentButtons = 0;    // 마지막으로 큐에 넣은 버튼 상태
+    bool    dirty = false;
+  } gM;
+  TxQueue<hid_mouse_report_t, 4> gMq;
+
+  // ---- Keyboard 상태 ----
+  constexpr uint8_t TAP_QUEUE = 32;
+  struct Tap { uint8_t mods, key; };
+  struct KeyState {
+    uint8_t mods = 0;           // 유지 모디파이어
+    uint8_t keys[6] = {0};      // 유지 키
+    Tap     q[TAP_QUEUE];
+    uint8_t qHead = 0, qCount = 0;
+    bool    tapDown = false;    // 탭이 눌린 상태로 큐에 들어감 → 다음 flush에 뗌
+    Tap     cur = {0, 0};
+    uint32_t lastTapMs = 0;     // 마지막 탭 누름 시각(속도 제한 기준)
+    bool    keysDirty = false;  // 유지 키/모디파이어 변경(탭 속도 제한과 무관하게 전송)
+    bool    dirty = false;
+  } gK;
+  TxQueue<hid_keyboard_report_t, 4> gKq;
+
+  // 탭 속도 제한: 탭 누름 사이 최소 간격(ms, 0 = flush마다)
+  uint16_t gTapHz = CFG_KBD_TAP_HZ;
+  uint16_t gTapIntervalMs = CFG_KBD_TAP_HZ ? (uint16_t)((1000 + CFG_KBD_TAP_HZ - 1) / CFG_KBD_TAP_HZ) : 0;
+  USBDev::TapStats gTapSt;
+
+  // 서로 상쇄되는 탭 쌍(큐 꼬리와 반대 탭이 들어오면 둘 다 제거)
+  constexpr Tap kOpposingTaps[][2] = {
+    { { KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_EQUAL }, { KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_MINUS } },   // 줌 인/아웃
+  };
+
+  inline bool tapsCancel(const Tap& a, const Tap& b){
+    for (const auto& p : kOpposingTaps){
+      if (a.mods == p[0].mods && a.key == p[0].key && b.mods == p[1].mods && b.key == p[1].key) return true;
+      if (a.mods == p[1].mods && a.key == p[1].key && b.mods == p[0].mods && b.key == p[0].key) return true;
+    }
+    return false;
+  }
+
+  inline void keyUpdateDirty(){ gK.dirty = gK.keysDirty || gK.tapDown || gK.qCount; }
+
+  // ---- Gamepad 상태 ----
+  // 표준 모드에서는 int8로 변환된 값을 저장 → 출력 값이 실제로 바뀐 경우에만 dirty
+  struct PadState {
+    int16_t  x = 0, y = 0, rx = 0, ry = 0;
+    uint16_t lt = 0, rt = 0;
+    uint32_t btns = 0;
+    bool     dirty = false;
+    uint32_t lastSendMs = 0;
+  } gP;
+  TxQueue<PadReport, 1> gPq;              // 절대값: 최신값 1개만 유지
+
+  // Q15 → int8 (lroundf(v·127)과 동일한 반올림)
+  inline int16_t q15ToI8(int32_t v){
+    if (v >  32767) v =  32767;
+    if (v < -32767) v = -32767;
+    return (v >= 0) ? (int16_t)((v * 127 + (1 << 14)) >> 15)
+                    : (int16_t)-(((-v) * 127 + (1 << 14)) >> 15);
+  }
+
+  // acc를 base에 더해 int8 범위로 자르고, 남은 양은 acc에 이월
+  inline int8_t takeI8(int32_t& acc, int8_t base = 0){
+    int32_t v = base + acc;
+    v = (v > 127) ? 127 : (v < -127) ? -127 : v;
+    acc -= v - base;
+    return (int8_t)v;
+  }
+
+  void mouseQueued(uint8_t btn){
+    gM.sentButtons = btn;
+    // 이번에 누른 클릭은 다음 flush에 뗌
+    if (gM.clickNow){ gM.buttons &= (uint8_t)~gM.clickNow; gM.clickNow = 0; }
+  }
+
+  // 남은 델타(±127 초과분)나 클릭 해제가 있으면 다음 flush에서 계속
+  inline void mouseUpdateDirty(){
+    gM.dirty = gM.dx || gM.dy || gM.wheel || gM.pan || gM.clickNow || (gM.sentButtons != gM.buttons);
+  }
+
+  void buildMouse(){
+    if (!gM.dirty) return;
+
+    const uint8_t btn = gM.buttons | gM.clickNow;
+    const bool moved = gM.dx || gM.dy || gM.wheel || gM.pan;
+
+    if (!gMq.empty() && !gM.clickNow && gMq.tail().buttons == btn){
+      // 같은 버튼 상태의 미전송 리포트에 델타 합산
+      hid_mouse_report_t& t = gMq.tail();
+      t.x     = takeI8(gM.dx,    t.x);
+      t.y     = takeI8(gM.dy,    t.y);
+      t.wheel = takeI8(gM.wheel, t.wheel);
+      t.pan   = takeI8(gM.pan,   t.pan);
+      st(Itf::Mouse).merged++;
+    } else if (gMq.full()){
+      // 큐가 가득 참 — 상태 모델에 그대로 남겨 다음 flush에서 합산
+      st(Itf::Mouse).merged++;
+      return;
+    } else if (moved || btn != gM.sentButtons){
+      hid_mouse_report_t r = {};
+      r.buttons = btn;
+      r.x     = takeI8(gM.dx);
+      r.y     = takeI8(gM.dy);
+      r.wheel = takeI8(gM.wheel);
+      r.pan   = takeI8(gM.pan);
+      gMq.push(r);
+      st(Itf::Mouse).queued++;
+      mouseQueued(btn);
+    }
+
+    mouseUpdateDirty();
+  }
+
+  void buildKeyboard(uint32_t now_ms){
+    if (!gK.dirty) return;
+    const bool tapDue = !gK.tapDown && gK.qCount &&
+                        (!gTapIntervalMs || now_ms - gK.lastTapMs >= gTapIntervalMs);
+    if (!gK.tapDown && !tapDue && !gK.keysDirty) return;      // 다음 탭은 속도 제한 대기
+    if (gKq.full()){ st(Itf::Keyboard).merged++; return; }   // 탭/상태는 모델에 유지
+
+    hid_keyboard_report_t r = {};
+    r.modifier = gK.mods;
+    for (uint8_t i = 0; i < 6; ++i) r.keycode[i] = gK.keys[i];
+
+    if (gK.tapDown){
+      // 직전 탭 뗌(유지 키/모디파이어만)
+      gK.tapDown = false;
+    } else if (tapDue){
+      gK.lastTapMs = now_ms;
+      gK.cur = gK.q[gK.qHead];
+      gK.qHead = (uint8_t)((gK.qHead + 1) % TAP_QUEUE);
+      gK.qCount--;
+      r.modifier |= gK.cur.mods;
+      for (uint8_t i = 0; i < 6; ++i){
+        if (!r.keycode[i]){ r.keycode[i] = gK.cur.key; break; }
+      }
+      gK.tapDown = true;
+    }
+    gK.keysDirty = false;
+    gKq.push(r);
+    st(Itf::Keyboard).queued++;
+
+    keyUpdateDirty();
+  }
+
+  // hat은 D-패드 입력이 없어 0(중립) 고정
+  inline void fillPadHiRes(PadReportHiRes& h){
+    h.x = gP.x; h.y = gP.y; h.rx = gP.rx; h.ry = gP.ry;
+    h.lt = gP.lt; h.rt = gP.rt;
+    h.hat = 0;
+    h.buttons = gP.btns;
+  }
+
+  // 통합 모드: 게임패드 + 포인터 상태를 프레임당 리포트 1개로(엔드포인트 전송 1회)
+  void buildCombo(uint32_t now_ms){
+    if (!gP.dirty && !gM.dirty) return;
+    if (now_ms - gP.lastSendMs < gPollMs) return;   // 간격 안 변경은 모델에 유지(델타는 계속 합산)
+
+    const uint8_t btn = gM.buttons | gM.clickNow;
+    if (!gPq.empty()){
+      // 미전송 리포트: 버튼 에지가 없으면 절대값 갱신 + 델타 합산, 있으면 다음 flush로
+      ComboReport& t = gPq.tail().combo;
+      if (gM.clickNow || t.mbuttons != btn){ st(Itf::Gamepad).merged++; return; }
+      fillPadHiRes(t.pad);
+      t.dx    = takeI8(gM.dx,    t.dx);
+      t.dy    = takeI8(gM.dy,    t.dy);
+      t.wheel = takeI8(gM.wheel, t.wheel);
+      t.pan   = takeI8(gM.pan,   t.pan);
+      st(Itf::Gamepad).merged++;
+    } else {
+      PadReport r = {};
+      fillPadHiRes(r.combo.pad);
+      r.combo.mbuttons = btn;
+      r.combo.dx    = takeI8(gM.dx);
+      r.combo.dy    = takeI8(gM.dy);
+      r.combo.wheel = takeI8(gM.wheel);
+      r.combo.pan   = takeI8(gM.pan);
+      gPq.push(r);
+      st(Itf::Gamepad).queued++;
+      mouseQueued(btn);
+    }
+    gP.dirty = false;
+    mouseUpdateDirty();
+  }
 
-  // 마지막 게임패드 전송 시각
-  uint32_t gLastGpSendMs = 0;
+  // TinyUSB 리포트: X, Y, Z, RZ, RX, RY, hat, buttons — 트리거는 Z/RZ(0..127)
+  inline void fillPadStd(hid_gamepad_report_t& s){
+    s.x = (int8_t)gP.x; s.y = (int8_t)gP.y; s.rx = (int8_t)gP.rx; s.ry = (int8_t)gP.ry;
+    s.z = (int8_t)gP.lt; s.rz = (int8_t)gP.rt;
+    s.hat = 0;
+    s.buttons = gP.btns;
+  }
+
+  void buildGamepad(uint32_t now_ms){
+    if (!gP.dirty) return;
+    if (now_ms - gP.lastSendMs < gPollMs) return;   // 폴링 간격 안 변경은 dirty로 유지(최신값 전송)
+
+    PadReport r = {};
+    if (gPadHiRes) fillPadHiRes(r.hi);
+    else           fillPadStd(r.std);
+
+    if (!gPq.empty()){ gPq.tail() = r; st(Itf::Gamepad).merged++; }   // 최신값 우선
+    else             { gPq.push(r);    st(Itf::Gamepad).queued++; }
+    gP.dirty = false;
+  }
+
+  // 큐 맨 앞 리포트 1개 전송 시도(엔드포인트가 바쁘면 false)
+  bool sendFront(uint8_t i, uint32_t now_ms){
+    bool ok = false;
+    switch ((Itf)i){
+      case Itf::Mouse:
+        if (gMq.empty()) return false;
+        ok = tud_hid_n_report(HID_ITF, RID_MOUSE, &gMq.front(), sizeof(hid_mouse_report_t));
+        if (ok) gMq.pop();
+        break;
+      case Itf::Keyboard:
+        if (gKq.empty()) return false;
+        ok = tud_hid_n_report(HID_ITF, RID_KEYBOARD, &gKq.front(), sizeof(hid_keyboard_report_t));
+        if (ok) gKq.pop();
+        break;
+      case Itf::Gamepad:
+        if (gPq.empty()) return false;
+        ok = tud_hid_n_report(HID_ITF, RID_GAMEPAD, &gPq.front(), padReportLen());
+        if (ok){ gPq.pop(); gP.lastSendMs = now_ms; }
+        break;
+      default: break;
+    }
+    if (ok) gStats[i].sent++;
+    return ok;
+  }
+
+  void drain(uint32_t now_ms){
+    // IN 엔드포인트 1개를 세 리포트 ID가 공유 — 전송 완료 전까지 tud_hid_n_ready()=false
+    for (uint8_t k = 0; k < (uint8_t)Itf::COUNT; ++k){
+      if (!tud_hid_n_ready(HID_ITF)) return;
+      const uint8_t i = (uint8_t)((gRR + k) % (uint8_t)Itf::COUNT);
+      if (sendFront(i, now_ms)){ gRR = (uint8_t)(i + 1) % (uint8_t)Itf::COUNT; return; }
+    }
+  }
 
-  // 중립 상태 캐시(불필요한 중복 전송을 줄이고 싶으면 사용 가능)
-  int8_t   gLastX  = 0, gLastY  = 0, gLastRX = 0, gLastRY = 0;
-  uint32_t gLastButtons = 0;
+  // 미마운트/서스펜드: 쌓인 리포트와 상대 이동은 버림(재개 시 튐 방지), 게임패드 최신 상태는 유지
+  void dropPending(){
+    st(Itf::Mouse).dropped    += gMq.count;
+    st(Itf::Keyboard).dropped += gKq.count + gK.qCount;
+    st(Itf::Gamepad).dropped  += gPq.count;
+    if (gPq.count) gP.dirty = true;
+    gMq.clear(); gKq.clear(); gPq.clear();
 
-  inline bool changed(int8_t X, int8_t Y, int8_t RX, int8_t RY, uint32_t btns){
-    return (X!=gLastX) || (Y!=gLastY) || (RX!=gLastRX) || (RY!=gLastRY) || (btns!=gLastButtons);
+    gM.dx = gM.dy = gM.wheel = gM.pan = 0;
+    gM.wheelFine = gM.panFine = 0;
+    gM.clickNow = 0;
+    gM.sentButtons = 0xFF;                // 재개 후 현재 버튼 상태를 한 번 다시 보냄
+    gM.dirty = true;
+    gK.qCount = 0; gK.tapDown = false;
+    gK.keysDirty = gK.dirty = true;
+  }
+
+  inline void keysAdd(uint8_t k){
+    for (uint8_t i = 0; i < 6; ++i) if (gK.keys[i] == k) return;
+    for (uint8_t i = 0; i < 6; ++i) if (!gK.keys[i]){ gK.keys[i] = k; gK.keysDirty = gK.dirty = true; return; }
+  }
+  inline void keysRemove(uint8_t k){
+    for (uint8_t i = 0; i < 6; ++i) if (gK.keys[i] == k){ gK.keys[i] = 0; gK.keysDirty = gK.dirty = true; }
   }
 }
 
@@ -33,19 +605,18 @@ void begin(const char* product,
   if (manufacturer) USB.manufacturerName(manufacturer);
   if (serial)       USB.serialNumber(serial);
 
+  // HID 인터페이스는 USB.begin() 전에 등록해야 설정 디스크립터에 포함됨
+  tinyusb_enable_interface(USB_INTERFACE_HID, TUD_HID_INOUT_DESC_LEN, loadHidDescriptor);
   USB.begin();
-  gMouse.begin();
-  gKeyboard.begin();
-  gGamepad.begin();
+  gBegun = true;
 
   // 첫 리포트는 중립으로
   gamepadNeutral();
 }
 
 bool ready() {
-  // TinyUSB에서 별도 “enumerated” 플래그는 없으므로,
-  // 일단 USB가 시작되었다고 가정. 필요하면 추가 상태를 여기서 추적.
-  return true;
+  // 호스트가 구성(SET_CONFIGURATION)을 마쳤고 서스펜드가 아님
+  return tud_mounted() && !tud_suspended();
 }
 
 void end() {
@@ -53,55 +624,249 @@ void end() {
   USB.end();
 }
 
+// ---- 전송 ----
+void flush(uint32_t now_ms) {
+  updateRates(now_ms);
+  if (!ready()){
+    dropPending();
+    return;
+  }
+
+  if (gCombined) {
+    buildCombo(now_ms);
+  } else {
+    buildMouse();
+    buildGamepad(now_ms);
+  }
+  buildKeyboard(now_ms);
+  drain(now_ms);
+}
+
+void getTxStats(Itf itf, TxStats& out) {
+  if ((uint8_t)itf >= (uint8_t)Itf::COUNT) { out = TxStats{}; return; }
+  out = gStats[(uint8_t)itf];
+  switch (itf) {
+    case Itf::Mouse:    out.pending = gMq.count; break;
+    case Itf::Keyboard: out.pending = gKq.count; break;
+    case Itf::Gamepad:  out.pending = gPq.count; break;
+    default: break;
+  }
+}
+
+void resetTxStats() {
+  for (auto& s : gStats) s = TxStats{};
+  gTapSt = TapStats{};
+  for (auto& s : gRateSent0) s = 0;
+}
+
+bool setPollMs(uint8_t ms) {
+  if (!validPoll(ms)) return false;
+  if (gBegun) return ms == gPollMs;       // 열거 후에는 변경 불가(다음 부팅부터)
+  gPollMs = ms;
+  return true;
+}
+
+uint8_t pollMs() { return gPollMs; }
+
+bool setGamepadHiRes(bool en) {
+  if (gBegun) return en == gPadHiRes;     // 열거 후에는 변경 불가(다음 부팅부터)
+  gPadHiRes = en;
+  return true;
+}
+
+bool gamepadHiRes() { return padWide(); }
+
+bool setCombined(bool en) {
+  if (gBegun) return en == gCombined;     // 열거 후에는 변경 불가(다음 부팅부터)
+  gCombined = en;
+  return true;
+}
+
+bool combined() { return gCombined; }
+
 // ---- Mouse ----
 void mouseMove(int x, int y, int wheel) {
-  gMouse.move(x, y, wheel);
+  if (!x && !y && !wheel) return;
+  gM.dx += x; gM.dy += y;
+  if (wheel) mouseWheel(wheel);
+  gM.dirty = true;
+}
+
+void mouseWheel(int wheel) { mouseWheelFine(wheel * WHEEL_FINE_PER_NOTCH); }
+void mousePan(int pan)     { mousePanFine(pan * WHEEL_FINE_PER_NOTCH); }
+
+void mouseWheelFine(int fine) {
+  if (!fine) return;
+  const int32_t u = fineToUnits(fine, gM.wheelFine, wheelHiRes());
+  if (!u) return;
+  gM.wheel += u;
+  gM.dirty = true;
+}
+
+void mousePanFine(int fine) {
+  if (!fine) return;
+  const int32_t u = fineToUnits(fine, gM.panFine, panHiRes());
+  if (!u) return;
+  gM.pan += u;
+  gM.dirty = true;
+}
+
+uint8_t wheelMultiplier() { return wheelHiRes() ? WHEEL_FINE_PER_NOTCH : 1; }
+uint8_t panMultiplier()   { return panHiRes()   ? WHEEL_FINE_PER_NOTCH : 1; }
+
+uint16_t getFeature(uint8_t reportId, uint8_t* buf, uint16_t len) {
+  if (reportId != RID_MOUSE_RES || !len) return 0;
+  buf[0] = gResMul;
+  return 1;
+}
+
+uint16_t getInputReport(uint8_t reportId, uint8_t* buf, uint16_t len) {
+  if (!buf) return 0;
+  uint16_t n = 0;
+  switch (reportId) {
+    case RID_KEYBOARD: {
+      hid_keyboard_report_t r = {};
+      r.modifier = gK.mods;
+      for (uint8_t i = 0; i < 6; ++i) r.keycode[i] = gK.keys[i];
+      n = sizeof(r);
+      if (len < n) return 0;
+      memcpy(buf, &r, n);
+    } break;
+    case RID_MOUSE: {
+      if (gCombined) return 0;                       // 통합 모드에는 마우스 ID 없음
+      hid_mouse_report_t r = {};
+      r.buttons = gM.buttons;
+      n = sizeof(r);
+      if (len < n) return 0;
+      memcpy(buf, &r, n);
+    } break;
+    case RID_GAMEPAD: {
+      PadReport r = {};
+      if (gCombined)      { fillPadHiRes(r.combo.pad); r.combo.mbuttons = gM.buttons; }
+      else if (gPadHiRes)   fillPadHiRes(r.hi);
+      else                  fillPadStd(r.std);
+      n = padReportLen();
+      if (len < n) return 0;
+      memcpy(buf, &r, n);
+    } break;
+    default: return 0;
+  }
+  return n;
+}
+
+bool setFeature(uint8_t reportId, const uint8_t* buf, uint16_t len) {
+  if (reportId != RID_MOUSE_RES || !len) return false;
+  // TinyUSB 버전에 따라 첫 바이트가 리포트 ID일 수 있음
+  const uint8_t v = (len >= 2 && buf[0] == RID_MOUSE_RES) ? buf[1] : buf[0];
+  gResMul = v & 0x0F;
+  return true;
 }
 
-void mouseClickLeft()  { gMouse.click(MOUSE_LEFT);  }
-void mouseClickRight() { gMouse.click(MOUSE_RIGHT); }
+void mouseClick(uint8_t buttons) {
+  gM.clickNow |= buttons;
+  gM.dirty = true;
+}
+
+void mouseClickLeft()  { mouseClick(MOUSE_BUTTON_LEFT);  }
+void mouseClickRight() { mouseClick(MOUSE_BUTTON_RIGHT); }
+void mousePressLeft()   { mousePress(MOUSE_BUTTON_LEFT);   }
+void mouseReleaseLeft() { mouseRelease(MOUSE_BUTTON_LEFT); }
 
-void mousePress(uint8_t buttons)   { gMouse.press(buttons);   }
-void mouseRelease(uint8_t buttons) { gMouse.release(buttons); }
-void mouseReleaseAll()             { gMouse.releaseAll();     }
+void mousePress(uint8_t buttons)   { gM.buttons |= buttons;             gM.dirty = true; }
+void mouseRelease(uint8_t buttons) { gM.buttons &= (uint8_t)~buttons;   gM.dirty = true; }
+void mouseReleaseAll()             { gM.buttons = 0; gM.clickNow = 0;   gM.dirty = true; }
 
 // ---- Keyboard ----
-void keyTap(uint8_t keycode) {
-  gKeyboard.write(keycode);
+void keyTap(uint8_t keycode, uint8_t mods) {
+  const Tap t{ mods, keycode };
+  gTapSt.taps++;
+  // 아직 누르지 않은 꼬리 탭과 상쇄되면 둘 다 없앰(줌 인 직후 줌 아웃 등)
+  if (gK.qCount && tapsCancel(gK.q[(gK.qHead + gK.qCount - 1) % TAP_QUEUE], t)) {
+    gK.qCount--;
+    gTapSt.cancelled += 2;
+    keyUpdateDirty();
+    return;
+  }
+  if (gK.qCount >= TAP_QUEUE) {   // 가득 차면 버림
+    st(Itf::Keyboard).dropped++;
+    gTapSt.overflow++;
+    return;
+  }
+  gK.q[(gK.qHead + gK.qCount) % TAP_QUEUE] = t;
+  gK.qCount++;
+  if (gK.qCount > gTapSt.maxDepth) gTapSt.maxDepth = gK.qCount;
+  gK.dirty = true;
 }
 
-void keyCombo(uint8_t mod1, uint8_t key) {
-  gKeyboard.press(mod1);
-  gKeyboard.write(key);
-  gKeyboard.releaseAll();
+void setKeyTapRate(uint16_t hz) {
+  gTapHz = hz;
+  gTapIntervalMs = hz ? (uint16_t)((1000u + hz - 1) / hz) : 0;
+}
+
+uint16_t keyTapRate() { return gTapHz; }
+
+uint8_t keyQueueDepth() { return gK.qCount; }
+
+void getTapStats(TapStats& out) {
+  out = gTapSt;
+  out.depth = gK.qCount;
 }
 
-void keyPress(uint8_t keycode)   { gKeyboard.press(keycode);   }
-void keyRelease(uint8_t keycode) { gKeyboard.release(keycode); }
-void keyReleaseAll()             { gKeyboard.releaseAll();     }
+void keyCombo(uint8_t mods, uint8_t keycode) { keyTap(keycode, mods); }
+
+void keyZoomIn()  { keyTap(HID_KEY_EQUAL, KEYBOARD_MODIFIER_LEFTCTRL); }
+void keyZoomOut() { keyTap(HID_KEY_MINUS, KEYBOARD_MODIFIER_LEFTCTRL); }
+
+void keyPress(uint8_t keycode)   { keysAdd(keycode);    }
+void keyRelease(uint8_t keycode) { keysRemove(keycode); }
+void keyModifiers(uint8_t mods)  { if (gK.mods != mods){ gK.mods = mods; gK.keysDirty = gK.dirty = true; } }
+
+void keyReleaseAll() {
+  gK.mods = 0;
+  for (uint8_t i = 0; i < 6; ++i) gK.keys[i] = 0;
+  gK.keysDirty = gK.dirty = true;
+}
 
 // ---- Gamepad ----
-void gamepadSend(int8_t X, int8_t Y, int8_t RX, int8_t RY, uint32_t btns) {
-  if (!changed(X,Y,RX,RY,btns)) {
-    return; // 중복 전송 방지(상위에서 주기 제한과 함께 사용 권장)
+void gamepadSet(int16_t X, int16_t Y, int16_t RX, int16_t RY, uint32_t btns,
+                uint16_t LT, uint16_t RT) {
+  if (LT > 32767) LT = 32767;
+  if (RT > 32767) RT = 32767;
+  if (!padWide()) {
+    X  = q15ToI8(X);  Y  = q15ToI8(Y);
+    RX = q15ToI8(RX); RY = q15ToI8(RY);
+    LT = (uint16_t)q15ToI8(LT); RT = (uint16_t)q15ToI8(RT);
+  } else {
+    if (X  < -32767) X  = -32767;
+    if (Y  < -32767) Y  = -32767;
+    if (RX < -32767) RX = -32767;
+    if (RY < -32767) RY = -32767;
   }
-  // v3.x API 형태: Gamepad.send(X, Y, Z, RZ, RX, RY, hat, buttons)
-  // 우리 장치는 Z/RZ를 0, hat=0x08(중립) 고정으로 사용
-  gGamepad.send(X, Y, 0, 0, RX, RY, 0x08, btns);
-
-  gLastX = X; gLastY = Y; gLastRX = RX; gLastRY = RY; gLastButtons = btns;
-  gLastGpSendMs = millis();
+  if (X == gP.x && Y == gP.y && RX == gP.rx && RY == gP.ry &&
+      LT == gP.lt && RT == gP.rt && btns == gP.btns) {
+    return; // 변화 없음 — dirty 유지 여부는 이전 상태 그대로
+  }
+  gP.x = X; gP.y = Y; gP.rx = RX; gP.ry = RY; gP.lt = LT; gP.rt = RT; gP.btns = btns;
+  gP.dirty = true;
 }
 
 void gamepadNeutral() {
-  gGamepad.send(0, 0, 0, 0, 0, 0, 0x08, 0);
-  gLastX = gLastY = gLastRX = gLastRY = 0;
-  gLastButtons = 0;
-  gLastGpSendMs = millis();
+  gP.x = gP.y = gP.rx = gP.ry = 0;
+  gP.lt = gP.rt = 0;
+  gP.btns = 0;
+  gP.dirty = true;
+  gP.lastSendMs = millis() - gPollMs;   // 다음 flush에서 즉시
 }
 
 uint32_t msSinceLastGamepadSend() {
-  return millis() - gLastGpSendMs;
+  return millis() - gP.lastSendMs;
 }
 
 } // namespace USBDev
+
+// 리포트 디스크립터(HID 인스턴스 0)
+extern "C" uint8_t const* tud_hid_descriptor_report_cb(uint8_t instance) {
+  (void)instance;
+  uint16_t len = 0;
+  return reportDesc(len);
+}
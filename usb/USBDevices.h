@@ -2,7 +2,14 @@
 //
 // USBDevices.h — USB HID (Mouse/Keyboard/Gamepad) 얇은 래퍼
 // - 상위(오케스트라)는 이 API만 사용
-// - 내부 구현은 Arduino ESP32-S3 TinyUSB 백엔드(USBHID*)에 위임
+// - HID 인터페이스/리포트 디스크립터는 직접 등록(TinyUSB), 폴링 간격(bInterval) 1/2/4/8ms 선택
+// - 인터페이스별 리포트 상태 모델 + dirty 비트
+//   · 파이프라인은 tick 동안 상태에만 기록(전송 없음)
+//   · tick 끝의 flush() 1회가 인터페이스당 최대 1개 리포트를 전송
+//   · 마우스 이동/휠은 flush 사이에 합산, 클릭은 이번 flush에 누름 → 다음 flush에 뗌
+// - 인터페이스별 송신 큐 + tud_hid_n_ready() 백프레셔(블로킹 전송 없음)
+//   · 큐가 가득 차면 상태 모델에 남김: 절대값(게임패드)은 최신값 우선, 마우스 델타는 합산
+//   · 미마운트/서스펜드 중에는 대기 리포트를 버리고 dropped로 집계
 //
 
 #include <Arduino.h>
@@ -10,31 +17,119 @@
 namespace USBDev {
 
 // ---- 초기화/수명주기 ----
+// HID 엔드포인트 폴링 간격(ms: 1|2|4|8). begin() 전에만 변경 가능(열거 시 디스크립터에 고정)
+// 게임패드 최소 전송 간격도 같은 값 사용
+bool    setPollMs(uint8_t ms);
+uint8_t pollMs();
+
+// 게임패드 리포트 형식: false = 표준(int8 축), true = 고해상도(int16 축 + 16비트 트리거)
+// begin() 전에만 변경 가능(리포트 디스크립터가 열거 시 고정)
+bool setGamepadHiRes(bool en);
+bool gamepadHiRes();                 // 통합 모드에서는 항상 true
+
+// 통합 리포트 모드: 게임패드(int16 축) + 포인터 버튼/상대 X·Y/휠/AC Pan을 리포트 ID 하나로
+//  - 입력 프레임당 IN 전송 1회, 호스트는 모든 입력을 같은 시점 샘플로 받음
+//  - 마우스 리포트 ID는 없어짐(키보드는 별도 유지). 포인터가 Gamepad 컬렉션 안에 있으므로
+//    OS 기본 마우스 드라이버는 커서로 쓰지 않음 — Linux evdev(REL 축)·전용 호스트 툴 용 명시적 opt-in(기본 off)
+//  - begin() 전에만 변경 가능
+bool setCombined(bool en);
+bool combined();
+
 void begin(const char* product,
            const char* manufacturer,
            const char* serial);
-bool ready();                    // USB.begin() 완료/에넘 OK 추정(간단 헬퍼)
+inline void init(const char* product, const char* manufacturer, const char* serial){
+  begin(product, manufacturer, serial);
+}
+bool ready();                    // 마운트됨 && 서스펜드 아님
 void end();                      // 필요시 USB 종료(일반적으론 사용 안 함)
 
-// ---- Mouse ----
-void mouseMove(int x, int y, int wheel = 0); // 상대 이동 + 휠
+// ---- 전송 ----
+// dirty 인터페이스마다 최대 1개 리포트를 큐에 넣고, 엔드포인트가 비어 있으면 전송(입력 tick 끝에서 1회 호출)
+void flush(uint32_t now_ms);
+
+enum class Itf : uint8_t { Mouse, Keyboard, Gamepad, COUNT };
+
+struct TxStats {
+  uint32_t queued  = 0;   // 큐에 새로 넣은 리포트
+  uint32_t merged  = 0;   // 미전송 리포트에 합산/덮어쓰기, 또는 큐가 가득 차 상태 모델에 유지
+  uint32_t dropped = 0;   // 미마운트/서스펜드/탭 큐 초과로 버린 리포트
+  uint32_t sent    = 0;   // 실제 전송
+  uint8_t  pending = 0;   // 현재 큐 길이
+  uint16_t rateHz  = 0;   // 실측 전송 속도(최근 1초 창)
+};
+
+void getTxStats(Itf itf, TxStats& out);
+void resetTxStats();
+
+// ---- Mouse (통합 모드에서는 게임패드 리포트에 실려 전송) ----
+void mouseMove(int x, int y, int wheel = 0); // 상대 이동 + 휠(다음 flush까지 합산)
+void mouseWheel(int wheel);                  // 노치 단위
+void mousePan(int pan);                      // 수평 스크롤(AC Pan), 노치 단위
+
+// 고해상도 휠/팬: 1/16 노치 단위
+//  - 호스트가 Resolution Multiplier 피처를 켜면(×16) 그대로 전송
+//  - 꺼져 있으면 노치로 모아 전송, 노치 미만 나머지는 다음 호출로 이월
+inline constexpr int WHEEL_FINE_PER_NOTCH = 16;
+void mouseWheelFine(int fine);
+void mousePanFine(int fine);
+uint8_t wheelMultiplier();                   // 1 또는 16(호스트 설정)
+uint8_t panMultiplier();
+
+// HID 피처 리포트(Resolution Multiplier) — TinyUSB get/set_report 콜백에서 위임
+// 처리한 경우 길이(get) / true(set), 다른 리포트 ID면 0 / false
+uint16_t getFeature(uint8_t reportId, uint8_t* buf, uint16_t len);
+bool     setFeature(uint8_t reportId, const uint8_t* buf, uint16_t len);
+
+// GET_REPORT(INPUT) — 키보드/마우스/게임패드 리포트 ID의 현재 상태(리포트 ID 바이트 제외)
+// 상대값(마우스 이동/휠)은 0. 이 인터페이스의 리포트 ID가 아니면 0
+uint16_t getInputReport(uint8_t reportId, uint8_t* buf, uint16_t len);
+
+// 이 HID 인터페이스에서 USBDev가 쓰는 리포트 ID 상한(벤더 리포트는 이보다 큰 ID 사용)
+inline constexpr uint8_t RID_RESERVED_MAX = 0x0F;
 void mouseClickLeft();
 void mouseClickRight();
-void mousePress(uint8_t buttons);            // MOUSE_LEFT 등 조합
+void mousePressLeft();                       // 드래그: 누른 채 유지 → mouseReleaseLeft
+void mouseReleaseLeft();
+void mouseClick(uint8_t buttons);            // 이번 flush 누름 → 다음 flush 뗌
+void mousePress(uint8_t buttons);            // MOUSE_BUTTON_LEFT 등 조합
 void mouseRelease(uint8_t buttons);
 void mouseReleaseAll();
 
-// ---- Keyboard ----
-void keyTap(uint8_t keycode);                // 단일 키 탭
-void keyCombo(uint8_t mod1, uint8_t key);    // 예) CTRL + '+'
+// ---- Keyboard (HID usage 코드 + 모디파이어 마스크) ----
+// keycode: HID_KEY_* (usage), mods: KEYBOARD_MODIFIER_* 비트
+void keyTap(uint8_t keycode, uint8_t mods = 0); // 탭 큐 → flush마다 누름/뗌 1단계씩(속도 제한)
+void keyCombo(uint8_t mods, uint8_t keycode);   // 예) CTRL + '='
+void keyZoomIn();                               // Ctrl + '='
+void keyZoomOut();                              // Ctrl + '-'
 void keyPress(uint8_t keycode);
 void keyRelease(uint8_t keycode);
+void keyModifiers(uint8_t mods);                // 유지 모디파이어 설정
 void keyReleaseAll();
 
-// ---- Gamepad (v3.x style) ----
-// X,Y,RX,RY: -127..+127
+// 탭 큐: 탭 누름을 최대 hz회/초로 퍼뜨림(0 = flush마다 1회), 유지 키 변경은 제한 없음
+//  - 아직 누르지 않은 꼬리 탭과 반대 탭(줌 인/아웃)이 들어오면 둘 다 제거
+//  - 큐(32)가 가득 차면 새 탭을 버림(dropped/overflow)
+void     setKeyTapRate(uint16_t hz);
+uint16_t keyTapRate();
+uint8_t  keyQueueDepth();        // 대기 중인 탭 수
+
+struct TapStats {
+  uint32_t taps      = 0;   // keyTap 호출 수
+  uint32_t cancelled = 0;   // 상쇄로 제거된 탭(쌍당 2)
+  uint32_t overflow  = 0;   // 큐 초과로 버린 탭
+  uint8_t  depth     = 0;   // 현재 대기 탭
+  uint8_t  maxDepth  = 0;   // 최대 대기 탭(resetTxStats까지)
+};
+void getTapStats(TapStats& out);
+
+// ---- Gamepad ----
+// X,Y,RX,RY: Q15 (-32767..+32767), LT/RT: 0..32767
+//  - 고해상도 모드는 그대로 전송, 표준 모드는 int8(-127..+127)로 반올림 변환
 // btns: 비트필드 (A=bit0, B=bit1, X=bit2, Y=bit3, L3=bit8, R3=bit9 등 상위 레이어에서 정의)
-void gamepadSend(int8_t X, int8_t Y, int8_t RX, int8_t RY, uint32_t btns);
+// 출력 값이 바뀐 경우에만 dirty — 전송은 flush에서(최소 간격 적용)
+void gamepadSet(int16_t X, int16_t Y, int16_t RX, int16_t RY, uint32_t btns,
+                uint16_t LT = 0, uint16_t RT = 0);
 
 // 중립 리포트(초기화 직후, 재보정 완료 등에서 호출)
 void gamepadNeutral();
@@ -43,3 +138,6 @@ void gamepadNeutral();
 uint32_t msSinceLastGamepadSend();
 
 } // namespace USBDev
+
+// 호출부 호환 별칭
+namespace USBDevices = USBDev;